@@ -0,0 +1,333 @@
+#include "Attacks.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Attacks {
+    bool UsePext = false;
+    bool UseAvx2 = false;
+    Magic RookMagics[64];
+    Magic BishopMagics[64];
+    Bitboard KnightAttacks[64];
+    Bitboard KingAttacks[64];
+    Bitboard PawnAttacks[2][64];
+    Bitboard Between[64][64];
+    Bitboard Line[64][64];
+}
+
+static Attacks::Indexing currentIndexing = Attacks::Indexing::Magic;
+static Attacks::Fill currentFill = Attacks::Fill::Scalar;
+
+// every relevant occupancy of every square gets its own entry
+static Bitboard RookTable[0x19000];
+static Bitboard BishopTable[0x1480];
+
+Bitboard Attacks::slidingAttacks(PieceType type, Square square, Bitboard occupied) {
+    static const int rookDirections[4][2] = {{1,0},{-1,0},{0,1},{0,-1}};
+    static const int bishopDirections[4][2] = {{1,1},{1,-1},{-1,1},{-1,-1}};
+    const int (*directions)[2] = type == PieceType::Rook ? rookDirections : bishopDirections;
+
+    Bitboard attacks = Bitboards::Empty;
+    for(int i = 0; i < 4; i++){
+        int file = (int) square.file() + directions[i][0];
+        int rank = (int) square.rank() + directions[i][1];
+        // walk the ray up to and including the first occupied square
+        while(file >= 0 && file < 8 && rank >= 0 && rank < 8){
+            unsigned index = rank * 8 + file;
+            attacks |= Bitboards::squareBB(index);
+            if(Bitboards::contains(occupied, index)) break;
+            file += directions[i][0];
+            rank += directions[i][1];
+        }
+    }
+    return attacks;
+}
+
+// xorshift64*, seeded so the magics are the same on every run
+static std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+
+static void initMagics(PieceType type, Attacks::Magic magics[64], Bitboard* table) {
+    constexpr Bitboard Rank1 = 0xFFULL, Rank8 = Rank1 << 56;
+    constexpr Bitboard FileA = 0x0101010101010101ULL, FileH = FileA << 7;
+
+    std::vector<Bitboard> occupancy(4096), reference(4096);
+    std::vector<int> epoch(4096, 0);
+    int attempt = 0;
+    // seeds per rank that are known to find magics after few attempts
+    const std::uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+    for(unsigned index = 0; index < 64; index++){
+        Square square = Square::fromIndexUnchecked(index);
+        Attacks::Magic& m = magics[index];
+
+        // pieces on the edges never block a ray, unless the slider itself stands on that edge
+        Bitboard edges = ((Rank1 | Rank8) & ~(Rank1 << (8 * square.rank())))
+                       | ((FileA | FileH) & ~(FileA << square.file()));
+        m.mask = Attacks::slidingAttacks(type, square, Bitboards::Empty) & ~edges;
+        m.shift = 64 - Bitboards::popCount(m.mask);
+        m.attacks = table;
+        std::uint64_t seed = seeds[square.rank()];
+
+        // enumerate all subsets of the mask (carry-rippler) with their attacks
+        int size = 0;
+        Bitboard subset = Bitboards::Empty;
+        do {
+            occupancy[size] = subset;
+            reference[size] = Attacks::slidingAttacks(type, square, subset);
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while(subset);
+
+        // try sparse random candidates until one maps every subset to a slot without a conflicting collision
+        for(int i = 0; i < size; ){
+            do {
+                m.magic = nextRandom(seed) & nextRandom(seed) & nextRandom(seed);
+            } while(Bitboards::popCount((m.mask * m.magic) >> 56) < 6);
+
+            attempt++;
+            for(i = 0; i < size; i++){
+                unsigned slot = m.magicIndex(occupancy[i]);
+                if(epoch[slot] < attempt){
+                    epoch[slot] = attempt;
+                    table[slot] = reference[i];
+                }
+                else if(table[slot] != reference[i]) break;
+            }
+        }
+        table += size;
+    }
+}
+
+// store the attacks of every relevant occupancy at the slot given by the current indexing
+static void fillTable(PieceType type, const Attacks::Magic magics[64], Bitboard* table) {
+    for(unsigned index = 0; index < 64; index++){
+        const Attacks::Magic& m = magics[index];
+        Square square = Square::fromIndexUnchecked(index);
+        Bitboard subset = Bitboards::Empty;
+        do {
+            table[m.index(subset)] = Attacks::slidingAttacks(type, square, subset);
+            subset = (subset - m.mask) & m.mask;
+        } while(subset);
+        table += Bitboard(1) << (64 - m.shift);
+    }
+}
+
+#if !defined(CHESS_ENGINE_INLINE_PEXT)
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("bmi2"))) unsigned Attacks::pext(Bitboard bb, Bitboard mask) {
+    return (unsigned) _pext_u64(bb, mask);
+}
+#else
+// no BMI2 on this architecture, pextSupported() is false so this is never used for lookups
+unsigned Attacks::pext(Bitboard bb, Bitboard mask) {
+    unsigned result = 0;
+    for(unsigned bit = 0; mask; bit++){
+        if(Bitboards::contains(bb, Bitboards::popLsb(mask))) result |= 1u << bit;
+    }
+    return result;
+}
+#endif
+#endif
+
+bool Attacks::pextSupported() {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 8) & 1;
+#else
+    return false;
+#endif
+}
+
+Attacks::Indexing Attacks::defaultIndexing() {
+    if(!pextSupported()) return Indexing::Magic;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    // Zen 1 and 2 implement PEXT in microcode, magics are faster there
+    if(__builtin_cpu_is("znver1") || __builtin_cpu_is("znver2")) return Indexing::Magic;
+#endif
+    return Indexing::Pext;
+}
+
+bool Attacks::setIndexing(Indexing indexing) {
+    if(indexing == Indexing::Pext && !pextSupported()) return false;
+    currentIndexing = indexing;
+    UsePext = indexing == Indexing::Pext;
+    fillTable(PieceType::Rook, RookMagics, RookTable);
+    fillTable(PieceType::Bishop, BishopMagics, BishopTable);
+    return true;
+}
+
+Attacks::Indexing Attacks::indexing() {
+    return currentIndexing;
+}
+
+// shifts towards higher squares for positive amounts
+static Bitboard shiftBy(Bitboard bb, int amount) {
+    return amount > 0 ? bb << amount : bb >> -amount;
+}
+
+// squares a ray along shift may enter without wrapping around the board edge
+static constexpr Bitboard NotFileA = ~Bitboards::FileA;
+static constexpr Bitboard NotFileH = ~Bitboards::FileH;
+
+// attacks of all sliders along one direction: the sliders are spread over empty squares in
+// steps of one, two and four squares, then moved one more square to include the blockers
+static Bitboard occludedFill(Bitboard sliders, Bitboard empty, int shift, Bitboard wrap) {
+    Bitboard propagate = empty & wrap;
+    sliders |= propagate & shiftBy(sliders, shift);
+    propagate &= shiftBy(propagate, shift);
+    sliders |= propagate & shiftBy(sliders, 2 * shift);
+    propagate &= shiftBy(propagate, 2 * shift);
+    sliders |= propagate & shiftBy(sliders, 4 * shift);
+    return shiftBy(sliders, shift) & wrap;
+}
+
+Bitboard Attacks::fillScalar(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+    Bitboard empty = ~occupied;
+    return occludedFill(rooks, empty, 8, ~Bitboards::Empty) | occludedFill(rooks, empty, -8, ~Bitboards::Empty)
+         | occludedFill(rooks, empty, 1, NotFileA) | occludedFill(rooks, empty, -1, NotFileH)
+         | occludedFill(bishops, empty, 9, NotFileA) | occludedFill(bishops, empty, -9, NotFileH)
+         | occludedFill(bishops, empty, 7, NotFileH) | occludedFill(bishops, empty, -7, NotFileA);
+}
+
+#if (defined(__x86_64__) && defined(__GNUC__)) || (defined(_MSC_VER) && defined(_M_X64))
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+Bitboard Attacks::fillAvx2(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+    // lanes north, east, north-east and north-west shift left, their opposites in the second register shift right
+    const __m256i shift1 = _mm256_setr_epi64x(8, 1, 9, 7);
+    const __m256i shift2 = _mm256_add_epi64(shift1, shift1);
+    const __m256i shift4 = _mm256_add_epi64(shift2, shift2);
+    const __m256i wrapUp = _mm256_setr_epi64x(-1, (long long) NotFileA, (long long) NotFileA, (long long) NotFileH);
+    const __m256i wrapDown = _mm256_setr_epi64x(-1, (long long) NotFileH, (long long) NotFileH, (long long) NotFileA);
+
+    __m256i up = _mm256_setr_epi64x((long long) rooks, (long long) rooks, (long long) bishops, (long long) bishops);
+    __m256i down = up;
+    __m256i empty = _mm256_set1_epi64x((long long) ~occupied);
+    __m256i propagateUp = _mm256_and_si256(empty, wrapUp);
+    __m256i propagateDown = _mm256_and_si256(empty, wrapDown);
+
+    up = _mm256_or_si256(up, _mm256_and_si256(propagateUp, _mm256_sllv_epi64(up, shift1)));
+    down = _mm256_or_si256(down, _mm256_and_si256(propagateDown, _mm256_srlv_epi64(down, shift1)));
+    propagateUp = _mm256_and_si256(propagateUp, _mm256_sllv_epi64(propagateUp, shift1));
+    propagateDown = _mm256_and_si256(propagateDown, _mm256_srlv_epi64(propagateDown, shift1));
+    up = _mm256_or_si256(up, _mm256_and_si256(propagateUp, _mm256_sllv_epi64(up, shift2)));
+    down = _mm256_or_si256(down, _mm256_and_si256(propagateDown, _mm256_srlv_epi64(down, shift2)));
+    propagateUp = _mm256_and_si256(propagateUp, _mm256_sllv_epi64(propagateUp, shift2));
+    propagateDown = _mm256_and_si256(propagateDown, _mm256_srlv_epi64(propagateDown, shift2));
+    up = _mm256_or_si256(up, _mm256_and_si256(propagateUp, _mm256_sllv_epi64(up, shift4)));
+    down = _mm256_or_si256(down, _mm256_and_si256(propagateDown, _mm256_srlv_epi64(down, shift4)));
+
+    up = _mm256_and_si256(_mm256_sllv_epi64(up, shift1), wrapUp);
+    down = _mm256_and_si256(_mm256_srlv_epi64(down, shift1), wrapDown);
+
+    // union of the eight lanes
+    __m256i both = _mm256_or_si256(up, down);
+    __m128i half = _mm_or_si128(_mm256_castsi256_si128(both), _mm256_extracti128_si256(both, 1));
+    return (Bitboard) _mm_cvtsi128_si64(_mm_or_si128(half, _mm_unpackhi_epi64(half, half)));
+}
+#else
+// no AVX2 on this architecture, avx2Supported() is false so this is never called through sliders()
+Bitboard Attacks::fillAvx2(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+    return fillScalar(rooks, bishops, occupied);
+}
+#endif
+
+bool Attacks::avx2Supported() {
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuidex(info, 7, 0);
+    return (info[1] >> 5) & 1;
+#else
+    return false;
+#endif
+}
+
+Attacks::Fill Attacks::defaultFill() {
+    return avx2Supported() ? Fill::Avx2 : Fill::Scalar;
+}
+
+bool Attacks::setFill(Fill fill) {
+    if(fill == Fill::Avx2 && !avx2Supported()) return false;
+    currentFill = fill;
+    UseAvx2 = fill == Fill::Avx2;
+    return true;
+}
+
+Attacks::Fill Attacks::fill() {
+    return currentFill;
+}
+
+// attacks of a piece that jumps by the given file and rank offsets
+static Bitboard stepAttacks(Square square, const int (*steps)[2], int count) {
+    Bitboard attacks = Bitboards::Empty;
+    for(int i = 0; i < count; i++){
+        int file = (int) square.file() + steps[i][0];
+        int rank = (int) square.rank() + steps[i][1];
+        if(file >= 0 && file < 8 && rank >= 0 && rank < 8) attacks |= Bitboards::squareBB(rank * 8 + file);
+    }
+    return attacks;
+}
+
+static void initStepAttacks() {
+    static const int knightSteps[8][2] = {{-1,-2},{1,-2},{-2,-1},{-2,1},{-1,2},{1,2},{2,1},{2,-1}};
+    static const int kingSteps[8][2] = {{-1,-1},{0,-1},{1,-1},{-1,0},{1,0},{-1,1},{0,1},{1,1}};
+    static const int whitePawnSteps[2][2] = {{-1,1},{1,1}};
+    static const int blackPawnSteps[2][2] = {{-1,-1},{1,-1}};
+
+    for(unsigned index = 0; index < 64; index++){
+        Square square = Square::fromIndexUnchecked(index);
+        Attacks::KnightAttacks[index] = stepAttacks(square, knightSteps, 8);
+        Attacks::KingAttacks[index] = stepAttacks(square, kingSteps, 8);
+        Attacks::PawnAttacks[(int) PieceColor::White][index] = stepAttacks(square, whitePawnSteps, 2);
+        Attacks::PawnAttacks[(int) PieceColor::Black][index] = stepAttacks(square, blackPawnSteps, 2);
+    }
+}
+
+static void initLines() {
+    for(unsigned from = 0; from < 64; from++){
+        Square fromSquare = Square::fromIndexUnchecked(from);
+        for(PieceType type : {PieceType::Rook, PieceType::Bishop}){
+            Bitboard fromAttacks = Attacks::slidingAttacks(type, fromSquare, Bitboards::Empty);
+            for(unsigned to = 0; to < 64; to++){
+                if(!Bitboards::contains(fromAttacks, to)) continue;
+                Square toSquare = Square::fromIndexUnchecked(to);
+                Bitboard toAttacks = Attacks::slidingAttacks(type, toSquare, Bitboards::Empty);
+                Attacks::Line[from][to] = (fromAttacks & toAttacks) | Bitboards::squareBB(from) | Bitboards::squareBB(to);
+                Attacks::Between[from][to] = Attacks::slidingAttacks(type, fromSquare, Bitboards::squareBB(to))
+                                           & Attacks::slidingAttacks(type, toSquare, Bitboards::squareBB(from));
+            }
+        }
+    }
+}
+
+// build the tables before main runs
+static struct MagicsInitializer {
+    MagicsInitializer() {
+        initMagics(PieceType::Rook, Attacks::RookMagics, RookTable);
+        initMagics(PieceType::Bishop, Attacks::BishopMagics, BishopTable);
+        if(Attacks::defaultIndexing() == Attacks::Indexing::Pext) Attacks::setIndexing(Attacks::Indexing::Pext);
+        Attacks::setFill(Attacks::defaultFill());
+        initStepAttacks();
+        initLines();
+    }
+} magicsInitializer;
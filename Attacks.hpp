@@ -0,0 +1,130 @@
+#ifndef CHESS_ENGINE_ATTACKS_HPP
+#define CHESS_ENGINE_ATTACKS_HPP
+
+#include "Bitboard.hpp"
+#include "Piece.hpp"
+#include "Square.hpp"
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(_M_X64))
+#include <immintrin.h>
+#define CHESS_ENGINE_INLINE_PEXT
+#endif
+
+// Attack sets of all pieces, looked up in tables that are built once at startup.
+namespace Attacks {
+    // how the occupancy relevant to a square is turned into an index in that square's table
+    enum class Indexing {
+        Magic, // multiply by a magic number and shift
+        Pext   // BMI2 parallel bit extract, only on CPUs that support it
+    };
+
+#if defined(CHESS_ENGINE_INLINE_PEXT)
+    inline unsigned pext(Bitboard bb, Bitboard mask) {
+        return (unsigned) _pext_u64(bb, mask);
+    }
+#else
+    // compiled for BMI2 on its own, only called after the CPU has been checked
+    unsigned pext(Bitboard bb, Bitboard mask);
+#endif
+
+    extern bool UsePext;
+
+    // how the attacks of all sliders of a side are filled at once
+    enum class Fill {
+        Scalar, // one ray direction after the other
+        Avx2    // four ray directions per AVX2 register, only on CPUs that support it
+    };
+
+    extern bool UseAvx2;
+
+    // fancy magic: the occupancy relevant to a square is hashed into that square's slice of a shared table
+    struct Magic {
+        Bitboard mask;
+        Bitboard magic;
+        const Bitboard* attacks;
+        unsigned shift;
+
+        unsigned magicIndex(Bitboard occupied) const {
+            return (unsigned) (((occupied & mask) * magic) >> shift);
+        }
+
+        unsigned index(Bitboard occupied) const {
+            return UsePext ? pext(occupied, mask) : magicIndex(occupied);
+        }
+    };
+
+    extern Magic RookMagics[64];
+    extern Magic BishopMagics[64];
+    extern Bitboard KnightAttacks[64];
+    extern Bitboard KingAttacks[64];
+    extern Bitboard PawnAttacks[2][64];
+    extern Bitboard Between[64][64];
+    extern Bitboard Line[64][64];
+
+    // whether the CPU supports BMI2 at all, and the indexing chosen for it at startup
+    bool pextSupported();
+    Indexing defaultIndexing();
+
+    // refill the tables for the given indexing, fails if Pext is not supported
+    bool setIndexing(Indexing indexing);
+    Indexing indexing();
+
+    // attacks of a rook or bishop on square found by walking its rays, used to build the tables
+    Bitboard slidingAttacks(PieceType type, Square square, Bitboard occupied);
+
+    // whether the CPU supports AVX2, and the fill chosen for it at startup
+    bool avx2Supported();
+    Fill defaultFill();
+
+    // fails if Avx2 is not supported
+    bool setFill(Fill fill);
+    Fill fill();
+
+    // Kogge-Stone occluded fill of the eight ray directions, the Avx2 one is compiled for AVX2 on its own
+    Bitboard fillScalar(Bitboard rooks, Bitboard bishops, Bitboard occupied);
+    Bitboard fillAvx2(Bitboard rooks, Bitboard bishops, Bitboard occupied);
+
+    inline Bitboard rook(Square square, Bitboard occupied) {
+        const Magic& m = RookMagics[square.index()];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard bishop(Square square, Bitboard occupied) {
+        const Magic& m = BishopMagics[square.index()];
+        return m.attacks[m.index(occupied)];
+    }
+
+    inline Bitboard queen(Square square, Bitboard occupied) {
+        return rook(square, occupied) | bishop(square, occupied);
+    }
+
+    // every square attacked by any of the rooks or bishops (queens belong to both), for attack maps of a whole side
+    inline Bitboard sliders(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+        return UseAvx2 ? fillAvx2(rooks, bishops, occupied) : fillScalar(rooks, bishops, occupied);
+    }
+
+    inline Bitboard knight(Square square) {
+        return KnightAttacks[square.index()];
+    }
+
+    inline Bitboard king(Square square) {
+        return KingAttacks[square.index()];
+    }
+
+    // squares a pawn of the given color on square captures on
+    inline Bitboard pawn(PieceColor color, Square square) {
+        return PawnAttacks[(int) color][square.index()];
+    }
+
+    // squares strictly between two squares on a common rank, file or diagonal, empty otherwise
+    inline Bitboard between(Square from, Square to) {
+        return Between[from.index()][to.index()];
+    }
+
+    // the whole rank, file or diagonal through two squares, empty if they are not aligned
+    inline Bitboard line(Square from, Square to) {
+        return Line[from.index()][to.index()];
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include "Bench.hpp"
+#include "Board.hpp"
+#include "Fen.hpp"
+#include "NegaMax.hpp"
+#include "Perft.hpp"
+#include "PrincipalVariation.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+static const char* const BenchPositions[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+};
+
+// visit every pseudo-legal move sequence up to depth, playing moves like the search does
+static std::uint64_t walk(Board& board, int depth) {
+    if(depth == 0) return 1;
+    Board::MoveVec moves;
+    board.pseudoLegalMoves(moves);
+    std::uint64_t nodes = 0;
+    for(const Move& move: moves){
+        if(NegaMax::moveMaking() == NegaMax::MoveMaking::CopyMake){
+            Position saved = board.position();
+            board.setPosition(doMove(saved, move));
+            nodes += walk(board, depth - 1);
+            board.setPosition(saved);
+        }
+        else {
+            board.makeMove(move);
+            nodes += walk(board, depth - 1);
+            board.reverseMove(move);
+        }
+    }
+    return nodes;
+}
+
+// quiescence nodes are listed on their own but count for the nodes per second
+static void report(std::ostream& os, const char* what, const char* mode, double seconds, std::uint64_t nodes = 0, std::uint64_t qnodes = 0) {
+    os << std::left << std::setw(8) << what << std::setw(13) << mode
+       << std::right << std::fixed << std::setprecision(3) << std::setw(9) << seconds << "s";
+    if(nodes > 0) os << std::setw(12) << nodes << " nodes";
+    if(qnodes > 0) os << std::setw(12) << qnodes << " qnodes";
+    if(nodes + qnodes > 0) os << std::setw(12) << std::setprecision(0) << (nodes + qnodes) / seconds << " nps";
+    os << '\n';
+}
+
+void Bench::compareMoveMaking(std::ostream& os, int depth) {
+    using Clock = std::chrono::steady_clock;
+    auto previous = NegaMax::moveMaking();
+    const std::pair<NegaMax::MoveMaking, const char*> modes[] = {
+        {NegaMax::MoveMaking::MakeUnmake, "make/unmake"},
+        {NegaMax::MoveMaking::CopyMake, "copy-make"},
+    };
+
+    for(auto [mode, name]: modes){
+        NegaMax::setMoveMaking(mode);
+        std::uint64_t walkNodes = 0;
+        double walkSeconds = 0;
+        double searchSeconds = 0;
+        for(const char* fen: BenchPositions){
+            Board board = *Fen::createBoard(fen);
+
+            auto start = Clock::now();
+            walkNodes += walk(board, depth);
+            walkSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+            std::vector<Move> pvMoves;
+            PrincipalVariation pv = PrincipalVariation(pvMoves, board);
+            // every search starts from an empty table, so the modes do the same work
+            NegaMax::clearHash();
+            start = Clock::now();
+            NegaMax::negamaxSearch(board, depth, - std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+                                   std::numeric_limits<time_t>::max(), pv);
+            searchSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        report(os, "walk", name, walkSeconds, walkNodes);
+        report(os, "search", name, searchSeconds);
+    }
+    NegaMax::setMoveMaking(previous);
+}
+
+void Bench::timeToDepth(std::ostream& os, int depth, unsigned threads) {
+    using Clock = std::chrono::steady_clock;
+    using ParallelSearch = NegaMax::ParallelSearch;
+    auto previousThreads = NegaMax::threads();
+    auto previousParallelSearch = NegaMax::parallelSearch();
+    const std::tuple<unsigned, ParallelSearch, const char*> modes[] = {
+        {1u, ParallelSearch::LazySmp, "1 thread"},
+        {threads, ParallelSearch::LazySmp, "Lazy SMP"},
+        {threads, ParallelSearch::YoungBrothersWait, "YBW"},
+    };
+    double oneThreadSeconds = 0;
+    std::uint64_t oneThreadNodes = 0;
+
+    for(auto [count, parallelSearch, name]: modes){
+        NegaMax::setThreads(count);
+        NegaMax::setParallelSearch(parallelSearch);
+        double seconds = 0;
+        std::uint64_t nodes = 0;
+        std::uint64_t qnodes = 0;
+        for(const char* fen: BenchPositions){
+            Board board = *Fen::createBoard(fen);
+            std::vector<Move> pvMoves;
+            PrincipalVariation pv = PrincipalVariation(pvMoves, board);
+            NegaMax::clearHash();
+            // the search reports its progress on std::cout, keep that out of the results
+            std::streambuf* coutBuffer = std::cout.rdbuf(nullptr);
+            auto start = Clock::now();
+            NegaMax::iterativeDeepening(board, - std::numeric_limits<int>::max(), std::numeric_limits<int>::max(),
+                                        std::numeric_limits<time_t>::max(), pv, std::nullopt, depth);
+            seconds += std::chrono::duration<double>(Clock::now() - start).count();
+            nodes += NegaMax::nodes();
+            qnodes += NegaMax::qnodes();
+            std::cout.rdbuf(coutBuffer);
+        }
+        report(os, "depth", name, seconds, nodes, qnodes);
+        if(count == 1){
+            oneThreadSeconds = seconds;
+            oneThreadNodes = nodes + qnodes;
+            continue;
+        }
+        // more nodes than one thread needs for the same depth is work the extra threads wasted
+        os << name << " on " << threads << " threads: time-to-depth speedup " << std::setprecision(2) << oneThreadSeconds / seconds
+           << "x, " << (double) (nodes + qnodes) / oneThreadNodes << "x the nodes of one thread\n";
+    }
+    NegaMax::setThreads(previousThreads);
+    NegaMax::setParallelSearch(previousParallelSearch);
+}
+
+std::uint64_t Bench::perftScaling(std::ostream& os, const Board& board, int depth, unsigned threads, std::size_t hashMegabytes) {
+    using Clock = std::chrono::steady_clock;
+    double oneThreadSeconds = 0;
+    std::uint64_t nodes = 0;
+
+    for(unsigned count: {1u, threads}){
+        Board local = board;
+        // the moves below the root are not part of the results
+        std::ostringstream divideOutput;
+        auto start = Clock::now();
+        nodes = Perft::divide(local, depth, divideOutput, count, hashMegabytes);
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::string mode = std::to_string(count) + (count == 1 ? " thread" : " threads");
+        report(os, "perft", mode.c_str(), seconds, nodes);
+        if(count == 1) oneThreadSeconds = seconds;
+        else if(seconds > 0) os << "Scaling: " << std::setprecision(2) << oneThreadSeconds / seconds << "x on " << threads << " threads\n";
+    }
+    return nodes;
+}
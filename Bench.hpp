@@ -0,0 +1,26 @@
+#ifndef CHESS_ENGINE_BENCH_HPP
+#define CHESS_ENGINE_BENCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+class Board;
+
+class Bench {
+public:
+    // time make/unmake against copy-make on a fixed set of positions, both for a
+    // plain walk of the move tree and for the search, and report the results to os
+    static void compareMoveMaking(std::ostream& os, int depth);
+
+    // time iterative deepening to depth on the same positions with one thread and with threads in
+    // both parallel searches, each search from an empty transposition table, and report the speedup
+    // and the nodes searched to os
+    static void timeToDepth(std::ostream& os, int depth, unsigned threads);
+
+    // run perft divide on board once with one thread and once with threads, each with a new cache of
+    // hashMegabytes, and report both node rates and the speedup to os. returns the node count
+    static std::uint64_t perftScaling(std::ostream& os, const Board& board, int depth, unsigned threads, std::size_t hashMegabytes);
+};
+
+#endif
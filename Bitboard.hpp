@@ -0,0 +1,73 @@
+#ifndef CHESS_ENGINE_BITBOARD_HPP
+#define CHESS_ENGINE_BITBOARD_HPP
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// One bit per square, bit i is set when the square with index i is part of the set.
+using Bitboard = std::uint64_t;
+
+namespace Bitboards {
+    constexpr Bitboard Empty = 0;
+    constexpr Bitboard FileA = 0x0101010101010101ULL;
+    constexpr Bitboard FileH = FileA << 7;
+    constexpr Bitboard Rank1 = 0xFFULL;
+
+    constexpr Bitboard rank(unsigned rank) {
+        return Rank1 << (8 * rank);
+    }
+
+    constexpr Bitboard file(unsigned file) {
+        return FileA << file;
+    }
+
+    // move every square by offset (a multiple of 8, plus or minus one file), dropping squares that leave the board
+    template<int Offset>
+    constexpr Bitboard shift(Bitboard bb) {
+        static_assert(Offset == 8 || Offset == -8 || Offset == 16 || Offset == -16
+                   || Offset == 7 || Offset == 9 || Offset == -7 || Offset == -9, "unsupported shift");
+        if constexpr (Offset == 9 || Offset == -7) bb &= ~FileH;
+        if constexpr (Offset == 7 || Offset == -9) bb &= ~FileA;
+        if constexpr (Offset > 0) return bb << Offset;
+        else return bb >> -Offset;
+    }
+
+    constexpr Bitboard squareBB(unsigned index) {
+        return Bitboard(1) << index;
+    }
+
+    constexpr bool contains(Bitboard bb, unsigned index) {
+        return (bb & squareBB(index)) != 0;
+    }
+
+    // index of the least significant set bit, bb must not be empty
+    inline unsigned lsb(Bitboard bb) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bb);
+        return index;
+#else
+        return __builtin_ctzll(bb);
+#endif
+    }
+
+    // remove the least significant set bit from bb and return its index
+    inline unsigned popLsb(Bitboard& bb) {
+        unsigned index = lsb(bb);
+        bb &= bb - 1;
+        return index;
+    }
+
+    inline int popCount(Bitboard bb) {
+#if defined(_MSC_VER)
+        return (int) __popcnt64(bb);
+#else
+        return __builtin_popcountll(bb);
+#endif
+    }
+}
+
+#endif
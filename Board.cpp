@@ -1,5 +1,6 @@
 #include "Board.hpp"
 #include "MoveGeneration.hpp"
+#include "Attacks.hpp"
 
 #include <ostream>
 #include <cassert>
@@ -10,329 +11,172 @@
 #include <chrono>
 #include <algorithm>
 #include "NegaMax.hpp"
-#include "Board.hpp"
-#include "Board.hpp"
 //#include "ValueVisitor.hpp"
 
 Board::Board()
 {
-    turn_ = PieceColor::White;
-    castlingright_ = CastlingRights::None;
-    captures = std::stack<std::pair<Piece,Move>>();
-    promotions = std::stack<std::pair<PieceType,Move>>();
-    enPassantSquares = std::stack<std::pair<Square,Move>>();
-    castlings = std::stack<std::pair<Move,Move>>();
+    position_.clear();
+    ply_ = 0;
+}
+
+Board::Board(const Board& other)
+    : position_(other.position_), history_(other.history_.begin(), other.history_.begin() + other.ply_), ply_(other.ply_)
+{
+}
+
+Board& Board::operator=(const Board& other) {
+    position_ = other.position_;
+    history_.assign(other.history_.begin(), other.history_.begin() + other.ply_);
+    ply_ = other.ply_;
+    return *this;
 }
 
 void Board::setPiece(const Square& square, const Piece::Optional& piece) {
-    if(!piece.has_value()) return;
-    Piece pieceNoOpt = (Piece) *piece;
-    std::shared_ptr<Piece> piecePtr = std::make_shared<Piece>(pieceNoOpt);
-    pieceMap_[square.index()] = piecePtr;
+    position_.removePiece(square);
+    if(piece.has_value()) position_.putPiece(square, *piece);
 }
 
 Piece::Optional Board::piece(const Square& square) const {
-    if(!pieceMap_.count(square.index())) return std::nullopt;
-    std::shared_ptr<Piece> res = pieceMap_.at(square.index());
-    return *res;
+    if(position_.isEmpty(square)) return std::nullopt;
+    return position_.pieceOn(square);
 }
 
 void Board::setTurn(PieceColor turn) {
-    turn_ = turn;
+    position_.setTurn(turn);
 }
 
 PieceColor Board::turn() const {
-    return turn_;
+    return position_.turn;
 }
 
-std::map< int, std::shared_ptr< Piece > > Board::pieceMap() const
-{
-    return pieceMap_;
+Bitboard Board::pieces() const {
+    return position_.pieces();
+}
+
+Bitboard Board::pieces(PieceColor color) const {
+    return position_.pieces(color);
+}
+
+Bitboard Board::pieces(PieceType type) const {
+    return position_.pieces(type);
+}
+
+Bitboard Board::pieces(PieceType type, PieceColor color) const {
+    return position_.pieces(type, color);
 }
 
 void Board::setCastlingRights(CastlingRights cr) {
-    castlingright_ = cr;
+    position_.setCastlingRights(cr);
 }
 
 void Board::addCastlingRights(CastlingRights cr){
-    castlingright_ |= cr;
+    position_.setCastlingRights(position_.castlingRights | cr);
 }
 
 void Board::removeCastlingRights(CastlingRights cr){
-    castlingright_ &= ~cr;
+    position_.setCastlingRights(position_.castlingRights & ~cr);
 }
 
 CastlingRights Board::castlingRights() const {
-    return castlingright_;
+    return position_.castlingRights;
 }
 
 void Board::setEnPassantSquare(Square::Optional square)
 {
-    enPassantSquare_ = square;
+    position_.setEnPassantSquare(square);
 }
 
 Square::Optional Board::enPassantSquare() const {
-    return enPassantSquare_;
+    return position_.enPassantSquare;
 }
 
-void Board::setGeneratedMovesBoardColor(std::shared_ptr<MoveVec> ptr){
-    generatedMovesBoardColor = ptr;
+void Board::setHalfmoveClock(unsigned halfmoveClock) {
+    position_.halfmoveClock = (std::uint16_t) halfmoveClock;
 }
 
-std::shared_ptr<Board::MoveVec> Board::getGeneratedMovesBoardColor() const{
-    return generatedMovesBoardColor;
+unsigned Board::halfmoveClock() const {
+    return position_.halfmoveClock;
 }
 
-void Board::setGeneratedMovesOtherColor(std::shared_ptr<MoveVec> ptr){
-    generatedMovesOtherColor = ptr;
+Zobrist::Key Board::key() const {
+    return position_.key;
 }
 
-std::shared_ptr<Board::MoveVec> Board::getGeneratedMovesOtherColor() const{
-    return generatedMovesOtherColor;
+Zobrist::Key Board::computeKey() const {
+    return position_.computeKey();
 }
 
-void Board::makeMove(const Move& move) {    
-    // piece to move
-    Piece pieceToMove = (Piece)* pieceMap_.at(move.from().index());
-    PieceType pieceToMoveType = pieceToMove.type(); // optional promotion piece type
-    
-    /* promotion */
-    // if promotion move => set promotionPieceType
-    if(move.promotion() != std::nullopt){ 
-        //push promotion on stack
-        promotions.push(std::make_pair(pieceToMove.type(), move));
-        //change type of piece to move
-        pieceToMoveType = (PieceType)* move.promotion();
-    }
-    
-    /* en passant */
-    //if move is to enPassantSquare and pieceToMove is pawn => capture opposing pawn
-    if(pieceToMove.type() == PieceType::Pawn && move.to() == (Square)* enPassantSquare() 
-        /*&& move.from().rank() == ((Square)* enPassantSquare()).rank()*/){ //TODO: more check needed
-        //std::cout << "in enPassant";
-        //push capture on stack
-        //captures.push(std::make_pair(*pieceMap().at(move.from().rank() * 8 + move.to().file()), move)); //TODO: ERROR HERE
-        //capture piece on index with same rank as from and same file as to
-        pieceMap_.erase(move.from().rank() * 8 + move.to().file());
-    }
-    // enPassantSquare was set => remove after this move
-    if(enPassantSquare() != std::nullopt) setEnPassantSquare(std::nullopt);
-
-    // set en passant square for next move: check if moved piece is pawn and has moved to placed from startrank
-    if(pieceToMove.type() == PieceType::Pawn && ( (move.from().rank() == 1 && move.to().rank() == 3) || (move.from().rank() == 6 && move.to().rank() == 4) )){
-        if(pieceToMove.color() == PieceColor::White) setEnPassantSquare(Square::fromCoordinates(move.to().file(),move.to().rank()-1));
-        if(pieceToMove.color() == PieceColor::Black) setEnPassantSquare(Square::fromCoordinates(move.to().file(),move.to().rank()+1));
-        //push en passant square on stack
-        //std::cout << "enpassent on move: " << move;
-        //std::cout << "enPassantSquare: " << (Square)* enPassantSquare();
-        enPassantSquares.push(std::make_pair((Square)* enPassantSquare(), move));
-    }
-    
-    /* regular checks */
-    //check regular capture
-    if(pieceMap().count(move.to().index())) { // if piece on move.to()
-        Piece pieceCaptured = (Piece)* pieceMap_.at(move.to().index());
-        if(pieceCaptured.color() != pieceToMove.color()){
-            captures.push(std::make_pair(pieceCaptured, move)); // push to captures stack
-            pieceMap_.erase(move.from().index()); // remove captured piece from piecemap
-        }
-    }
-    // set moving piece to
-    setPiece(move.to(), Piece(pieceToMove.color(), pieceToMoveType)); // ,(PieceType)* move.promotion()));
-    // erase moving piece from
-    pieceMap_.erase(move.from().index());
-    
-    /* castling */
-    // perform castling
-    // if move moves king two vertical spaces => castling happens, thus move rook
-    if(pieceToMove.type() == PieceType::King && abs((int) move.from().file() - (int) move.to().file()) == 2){
-        int oldRookOffsetWRTKing = 1; int newRookOffsetWRTking = -1; // moved right
-        if((int)(move.from().file() - move.to().file()) > 0){ oldRookOffsetWRTKing = -2; newRookOffsetWRTking = 1;} // moved left 
-        Piece rook = *pieceMap_.at(move.to().index()+oldRookOffsetWRTKing);
-        setPiece((Square)* Square::fromIndex(move.to().index()+newRookOffsetWRTking), rook); // move rook
-        pieceMap_.erase(move.to().index()+oldRookOffsetWRTKing); // remove old rook
-        //push rook move alongside this move on castling stack
-        castlings.push(std::make_pair(Move((Square)* Square::fromIndex(move.to().index()+oldRookOffsetWRTKing),
-                                           (Square)* Square::fromIndex(move.to().index()+newRookOffsetWRTking)), move));
-    }
-    // update castling rights
-    updateCastlingRights(pieceToMove, move);
-    
-    
-    //switch turn
-    setTurn(!turn());
+const Position& Board::position() const {
+    return position_;
+}
+
+void Board::setPosition(const Position& position) {
+    position_ = position;
+}
+
+void Board::makeMove(const Move& move) {
+    if(ply_ == history_.size()) history_.resize(std::max<std::size_t>(64, 2 * history_.size()));
+    StateInfo& state = history_[ply_++];
+    state.key = position_.key;
+    state.halfmoveClock = position_.halfmoveClock;
+    state.castlingRights = position_.castlingRights;
+    state.enPassantSquare = position_.enPassantSquare;
+    state.capturedPiece = position_.applyMove(move);
+    assert(position_.key == position_.computeKey());
 }
 
 void Board::reverseMove(const Move& move){
-    //std::cout << "reverse move----";
-    // piece to unmove
-    Piece pieceToMove = (Piece)* pieceMap_.at(move.to().index());
-
-    /* promotion */
-    // if move had promotion => unperform promotion: set piece with type from top of stack and remove from stack
-    if(move.promotion() != std::nullopt && !promotions.empty() && std::get<1>(promotions.top()) == move){
-        setPiece(move.from(), Piece(pieceToMove.color(),std::get<0>(promotions.top()))); 
-        pieceMap_.erase(move.to().index()); // erase moving piece
-        promotions.pop();
-    }
-    /* en passant */
-    /*else if(!enPassantSquares.empty() && std::get<1>(enPassantSquares.top()) == move){
-        setPiece(move.from(),pieceToMove);    
-        pieceMap_.erase(move.to().index()); // erase piece that was captured en passant
-    }*/
+    assert(ply_ > 0);
+    const StateInfo& state = history_[--ply_];
+    if(position_.pieceOn(move.to()).color() == PieceColor::White) reverseMove<PieceColor::White>(move, state);
+    else reverseMove<PieceColor::Black>(move, state);
+
+    // restore the state saved by makeMove, this also restores the key
+    position_.castlingRights = state.castlingRights;
+    position_.enPassantSquare = state.enPassantSquare;
+    position_.halfmoveClock = state.halfmoveClock;
+    position_.turn = !position_.turn;
+    position_.key = state.key;
+    assert(position_.key == position_.computeKey());
+}
+
+template<PieceColor Us>
+void Board::reverseMove(const Move& move, const StateInfo& state){
+    constexpr int Up = Us == PieceColor::White ? 8 : -8;
+    constexpr Square KingStart = Us == PieceColor::White ? Square::E1 : Square::E8;
+
+    // piece to unmove, a promoted piece turns back into a pawn
+    PieceType pieceToMoveType = move.promotion().has_value() ? PieceType::Pawn : position_.pieceOn(move.to()).type();
+    position_.removePiece(move.to());
+    position_.putPiece(move.from(), Piece(Us, pieceToMoveType));
+
     /* castling */
-    // if move had castling =>
-    else if(!castlings.empty() && std::get<1>(castlings.top()) == move){
-        setPiece(move.from(), pieceToMove); // reset king
-        pieceMap_.erase(move.to().index()); // erase moving piece
-        Move castlingMove = std::get<0>(castlings.top());
-        if(pieceMap_.count(castlingMove.to().index())){
-            Piece otherPieceToMove = (Piece)* pieceMap_.at(castlingMove.to().index());
-            setPiece(castlingMove.from(), otherPieceToMove); //reset other piece
-            pieceMap_.erase(castlingMove.to().index()); // erase moving piece
-            castlings.pop();
-        }
-        // TODO reset castlingrights
-    }
-    else{ // unmove piece normally
-        setPiece(move.from(),pieceToMove);    
-        pieceMap_.erase(move.to().index()); // erase moving piece
-    }
-        
-        
-    //unperform capture
-    if(!captures.empty() && std::get<1>(captures.top()) == move && pieceMap().count(move.from().index())){ //check top of captures stack for move
-        // unperform en passant capture (if just reset piece is pawn and move.to was enPassantSquare)
-        std::optional<Piece> piece = *pieceMap().at(move.from().index());
-        if( ((Piece)* piece).type() == PieceType::Pawn && !enPassantSquares.empty() && 
-            std::get<0>(enPassantSquares.top()) == move.to()){
-        //if(false){
-            //std::cout << "in reset en passant capture";
-            //std::cout << "piece: " << move.from().index();
-            //reset capture piece
-            if(turn() == PieceColor::Black){
-                setPiece((Square)* Square::fromCoordinates(move.to().file(), move.to().rank()-1), std::get<0>(captures.top()));
-                //std::cout << "move.to x,y: " << move.to().file() << " " << move.to().rank()-1;
-            }
-            else setPiece((Square)* Square::fromCoordinates(move.to().file(), move.to().rank()+1), std::get<0>(captures.top()));
-        }
-        // unperform normal capture    
-        else //reset capture piece */
-            setPiece(move.to(), std::get<0>(captures.top())); //reset capture piece
-        // remove captured piece from captures
-        captures.pop();
-    }
-    
-    /* en passant */
-    // if move set an en passant square => unset it and 
-    if(!enPassantSquares.empty() && std::get<1>(enPassantSquares.top()) == move){
-        enPassantSquares.pop();
-        if(!enPassantSquares.empty()) setEnPassantSquare(std::get<0>(enPassantSquares.top()));
-        else setEnPassantSquare(std::nullopt);
+    // if the king moved two files from its start square => move the rook back
+    if(pieceToMoveType == PieceType::King && move.from() == KingStart){
+        if(move.to().index() == KingStart.index() + 2)
+            position_.movePiece(Square::fromIndexUnchecked(KingStart.index() + 1), Square::fromIndexUnchecked(KingStart.index() + 3));
+        else if(move.to().index() + 2 == KingStart.index())
+            position_.movePiece(Square::fromIndexUnchecked(KingStart.index() - 1), Square::fromIndexUnchecked(KingStart.index() - 4));
     }
-    if(enPassantSquare() != std::nullopt) setEnPassantSquare(std::nullopt);
-    
-    //switch turn
-    setTurn(!turn());
-}
 
-void Board::updateCastlingRights(Piece pieceToMove, const Move& move){
-    // Rule 1: king and rook can not have moved already OK
-    // Rule 2: king moves two spaces vertically: if 2 to the left, rook to the right of that and vise versa OK
-    // Rule 3: king can't castle when in check OR if king goes 'through' a check (meaning if one square to the
-    //         left is in check => no leftside castling and vise versa) OR if king lands on check after castling. NOK
-    // Rule 4: no pieces in between king and rook. OK
-    
-    /* Black */
-    // king and rook can not have moved already
-    // if black king moves = remove black castling rights
-    if(pieceToMove.type() == PieceType::King && pieceToMove.color() == PieceColor::Black && !blackKingHasMoved){
-        removeCastlingRights(CastlingRights::Black); 
-        blackKingHasMoved = true;
-    }
-    // if black rook moves
-    if(pieceToMove.type() == PieceType::Rook && pieceToMove.color() == PieceColor::Black){
-        if(move.from().file() < 5 && !blackLeftRookHasMoved){
-            removeCastlingRights(CastlingRights::BlackQueenside); // left rook removes queenside rights
-            blackLeftRookHasMoved = true;
-        }
-        else{ 
-            removeCastlingRights(CastlingRights::BlackKingside); // right rook removes kingside rights
-            blackRightRookHasMoved = true;
-        }
+    /* captures */
+    // put the captured piece back, behind move.to() if it was taken en passant
+    if(state.capturedPiece != Position::NoPiece){
+        Square capturedSquare = move.to();
+        if(pieceToMoveType == PieceType::Pawn && state.enPassantSquare.has_value() && move.to() == *state.enPassantSquare)
+            capturedSquare = Square::fromIndexUnchecked(move.to().index() - Up);
+        position_.putPiece(capturedSquare, Piece::fromIndex(state.capturedPiece));
     }
-    
-    bool pieceInBetweenWhiteKingAndRightRook = pieceInBetween((Square)* Square::fromIndex(4), (Square)* Square::fromIndex(7));
-    // if pieces in between king and right rook
-    if(pieceInBetweenWhiteKingAndRightRook) removeCastlingRights(CastlingRights::WhiteKingside);
-    // if NO pieces in between king and right rook and has queen side rigths 
-    if(!pieceInBetweenWhiteKingAndRightRook && !blackKingHasMoved && !blackRightRookHasMoved) addCastlingRights(CastlingRights::BlackKingside);
-    
-    bool pieceInBetweenWhiteKingAndLeftRook = pieceInBetween((Square)* Square::fromIndex(4), (Square)* Square::fromIndex(0));
-    // if pieces in between king and right rook
-    if(pieceInBetweenWhiteKingAndLeftRook) removeCastlingRights(CastlingRights::WhiteQueenside);
-    // if NO pieces in between king and right rook and has queen side rigths 
-    if(!pieceInBetweenWhiteKingAndLeftRook && !blackKingHasMoved && !blackLeftRookHasMoved) addCastlingRights(CastlingRights::BlackKingside);
-    
+}
 
-    /* White */
-    // king and rook can not have moved already
-    // if white king moves = remove white castling rights
-    if(pieceToMove.type() == PieceType::King && pieceToMove.color() == PieceColor::White && !whiteKingHasMoved){
-        removeCastlingRights(CastlingRights::White); 
-        whiteKingHasMoved = true;
-    }
-    // if white rook moves
-    if(pieceToMove.type() == PieceType::Rook && pieceToMove.color() == PieceColor::White){
-        if(move.from().file() < 5 && !whiteLeftRookHasMoved){
-            removeCastlingRights(CastlingRights::WhiteQueenside); // left rook removes queenside rights
-            whiteLeftRookHasMoved = true;
-        }
-        else{ 
-            removeCastlingRights(CastlingRights::WhiteKingside); // right rook removes kingside rights
-            whiteRightRookHasMoved = true;
-        }
-    }
-    
-    bool pieceInBetweenBlackKingAndRightRook = pieceInBetween((Square)* Square::fromIndex(60), (Square)* Square::fromIndex(63));
-    // if pieces in between king and right rook
-    if(pieceInBetweenBlackKingAndRightRook) removeCastlingRights(CastlingRights::WhiteKingside);
-    // if NO pieces in between king and right rook and has queen side rigths 
-    if(!pieceInBetweenBlackKingAndRightRook && !whiteKingHasMoved && !whiteRightRookHasMoved) addCastlingRights(CastlingRights::WhiteKingside);
-    
-    bool pieceInBetweenBlackKingAndLeftRook = pieceInBetween((Square)* Square::fromIndex(60), (Square)* Square::fromIndex(56));
-    // if pieces in between king and right rook
-    if(pieceInBetweenBlackKingAndLeftRook) removeCastlingRights(CastlingRights::WhiteQueenside);
-    // if NO pieces in between king and right rook and has queen side rigths 
-    if(!pieceInBetweenBlackKingAndLeftRook && !blackKingHasMoved && !whiteLeftRookHasMoved) addCastlingRights(CastlingRights::WhiteQueenside);
-    
-    
-    /* check rules */
-    // check if king of next move in check
-    /*if(isCheck()){
-        if(turn() == PieceColor::White) removeCastlingRights(CastlingRights::White);
-        else removeCastlingRights(CastlingRights::White);
-    }*/
-    // check if rook in check
-    /*if(pieceToMove.type() == PieceType::King && abs((int) move.from().file() - (int) move.to().file()) == 2){
-        if(Board::pieceInCapturingZone(*this, )){
-    
-    }*/
+void Board::updateCastlingRights(const Move& move){
+    position_.updateCastlingRights(move);
 }
 
 bool Board::castlingRightsHave(CastlingRights cr) const {
     return (castlingRights() & cr) != CastlingRights::None;
 }
 
-bool Board::pieceInBetween(Square square1, Square square2){
-    int factor = 1;
-    if(square1.index() < square2.index()) factor = -1;
-    for(int i = 0; i < std::abs( (int) (square1.index() - square2.index())); i++){
-        if(pieceMap().count(square1.index()+(factor*i))) return true;
-    }
-    return false;
-}
-
 void Board::pseudoLegalMoves(MoveVec& moves) const {
     MoveGeneration::generatePseudoLegalMoves(*this, moves);
 }
@@ -341,6 +185,10 @@ void Board::pseudoLegalMovesFrom(const Square& from, MoveVec& moves) const{
     MoveGeneration::generatePseudoLegalMoves(*this, moves, from);
 }
 
+void Board::legalMoves(MoveVec& moves) const {
+    MoveGeneration::generateLegalMoves(*this, moves);
+}
+
 void Board::printPossibleMoves(const Board& board, std::set<Move> generatedMoves) const{
     std::vector<Square> moves;
     
@@ -352,10 +200,9 @@ void Board::printPossibleMoves(const Board& board, std::set<Move> generatedMoves
                 std::cout << " o "; movePrinted = true; break;
                 }
             }
-            if(pieceMap_.count(i * 8 + j)){
-                if(!movePrinted){
-                std::shared_ptr<Piece> res = board.pieceMap().at(i * 8 + j);
-                std::cout << " " << *res << " ";}
+            Piece::Optional piece = board.piece(Square::fromCoordinatesUnchecked(j, i));
+            if(piece.has_value()){
+                if(!movePrinted) std::cout << " " << *piece << " ";
             }
             else if(!movePrinted) std::cout << " . ";
         }
@@ -375,106 +222,42 @@ int Board::pieceValue(PieceType type) const
     }
 }
 
-int Board::evaluate(MoveVec& generatedMovesBoardColor, MoveVec& generatedMovesOtherColor)
+int Board::evaluate()
 {
     // Currently counting all piece scores. Implement better one later ex: Center control etc.
     int myPieceValues = 0;
     int otherPieceValues = 0;
-    int* evalValue = nullptr;
-    for (auto const& [key, val] : pieceMap()){
-        Piece piece = *val;
-        evalValue = piece.color() == turn() ? &myPieceValues : &otherPieceValues;
-        *evalValue = *evalValue + pieceValue(piece.type());
+    for (PieceType type : {PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen}){
+        myPieceValues += pieceValue(type) * Bitboards::popCount(pieces(type, turn()));
+        otherPieceValues += pieceValue(type) * Bitboards::popCount(pieces(type, !turn()));
     }
     
-    //if(turn() == PieceColor::White) std::cout << " turn: White";
-    //else std::cout << " turn: Black";
-    
     // penalize board for being in check and return worst possible score for being checkmate
-    if(isCheck(generatedMovesOtherColor)){
-        *evalValue = *evalValue - 1000;
-        if(isCheckMate(generatedMovesBoardColor, generatedMovesOtherColor)){ /*std::cout << "in checkmate";*/ return - std::numeric_limits<int>::max();}
+    if(isCheck()){
+        myPieceValues = myPieceValues - 1000;
+        if(isCheckMate()) return - std::numeric_limits<int>::max();
     }
 
     int finalEval = myPieceValues - otherPieceValues;
-    //int factor = turn() == PieceColor::White ? 1 : -1;
     return finalEval;
 }
 
-/*bool Board::sortByScore(Move& move1, Move& move2) {
-    return (move1.score(*this) < move2.score(*this));
-}*/
-
-struct CustomMove
-{
-    Move move; int score;
-    CustomMove(Move move, int score) : move(move), score(score) {}
-    bool operator < (CustomMove move2) const{ return (score < move2.score); }
-};
-
-Board::MoveVec Board::orderMoves(MoveVec& generatedMoves)
-{
-    for(Move move: generatedMoves){ 
-        // save piece that moves & potential captured piece
-        if(!pieceMap().count((int) move.from().index())) continue;
-        Piece movePiece = *(pieceMap().at((int) move.from().index()));
-        std::optional<Piece> capturedPiece;
-        if(pieceMap().count((int)move.to().index())) capturedPiece = *(pieceMap().at((int) move.to().index()));
-        makeMove(move);
-        int score = move.score(*this, movePiece, capturedPiece);
-        move.setScore(score);
-        reverseMove(move);
-    }
-    //std::cout << "unordered moves: \n"; 
-    //for(Move move : generatedMoves) std::cout << move;
-    // fill custom sorter vector
-    std::vector<CustomMove> vec;
-    for(Move move : generatedMoves){
-        if(move.getScore() > 100000000 || move.getScore() < -100000000) vec.push_back(CustomMove(move, 0));
-        else vec.push_back(CustomMove(move, move.getScore()));
-    }
-    // sort custom sorter vector
-    std::sort(vec.begin(), vec.end());
-    // refill generatedMoves with sorted generatedMoves
-    generatedMoves.clear();
-    for(CustomMove move : vec) generatedMoves.push_back(move.move);
-    //std::reverse(generatedMoves.begin(), generatedMoves.end());
-    //std::cout << "\n ordered moves: \n"; 
-    //for(Move move : generatedMoves) std::cout << move << " score: " << move.getScore() << " ";
-    return generatedMoves;
-}
-
-bool Board::pieceInCapturingZone(Board board, int index){    
-    // check possible moves of opposing color
-    board.setTurn(!board.turn());
-    Board::MoveVec moves;
-    board.pseudoLegalMoves(moves);
-    board.setTurn(!board.turn());
-    // check if given index is in any moves.to
-    for(Move move: moves){
-        if((int) move.to().index() == index) return true;
-    }
-    return false;
+bool Board::pieceInCapturingZone(const Board& board, int index){
+    // attacked by a piece of the opposing color
+    return board.isSquareAttacked(Square::fromIndexUnchecked(index), !board.turn());
 }
 
 std::vector<int> Board::findPieceIndices(PieceType pieceType, PieceColor color) const{
     std::vector<int> indices = std::vector<int>();
-    for (auto const& [key, val] : pieceMap()){
-        std::shared_ptr<Piece> piecePtr = val;
-        if(*piecePtr == Piece(color, pieceType))
-            indices.push_back(key);
-    }
+    Bitboard bb = pieces(pieceType, color);
+    while(bb) indices.push_back(Bitboards::popLsb(bb));
     return indices;
 }
 
 std::optional<int> Board::findKingIndex(PieceColor color) const{
-    std::optional<int> index;
-    for (auto const& [key, val] : pieceMap()){
-        std::shared_ptr<Piece> piecePtr = val;
-        if(*piecePtr == Piece(color, PieceType::King))
-            index = key;
-    }
-    return index;
+    Bitboard kings = pieces(PieceType::King, color);
+    if(!kings) return std::nullopt;
+    return Bitboards::lsb(kings);
 }
 
 std::vector<int> Board::getMoveToIndices(MoveVec& moves) const{
@@ -492,102 +275,319 @@ std::vector<int> Board::calculateIntersection(std::vector<int>& vector1, std::ve
     return result;
 }
 
-bool Board::isCheck(MoveVec& generatedMovesOtherColor, std::optional< int > kingIndex, std::optional< PieceColor > color)
-{    
-    // set optional turn of board
-    PieceColor turnOfBoard = turn();
-    if(color != std::nullopt) turnOfBoard = (PieceColor)* color;
-    
-    // find king on board if no index given
-    if(kingIndex != std::nullopt) kingIndex = (int)* kingIndex;
-    else {
-        std::optional<int> index = findKingIndex(turnOfBoard);
-        if(index != std::nullopt) kingIndex = (int)* index;
-        else return false;
+Bitboard Board::attackersTo(Square square, Bitboard occupied) const {
+    // a piece attacks square if the same kind of piece on square would attack it
+    Bitboard rooks = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishops = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+    return (Attacks::pawn(PieceColor::White, square) & pieces(PieceType::Pawn, PieceColor::Black))
+         | (Attacks::pawn(PieceColor::Black, square) & pieces(PieceType::Pawn, PieceColor::White))
+         | (Attacks::knight(square) & pieces(PieceType::Knight))
+         | (Attacks::king(square) & pieces(PieceType::King))
+         | (Attacks::rook(square, occupied) & rooks)
+         | (Attacks::bishop(square, occupied) & bishops);
+}
+
+Bitboard Board::attackersTo(Square square) const {
+    return attackersTo(square, pieces());
+}
+
+bool Board::isSquareAttacked(Square square, PieceColor by) const {
+    // cheap non-slider lookups first, the slider lookups only when those find nothing
+    if(Attacks::pawn(!by, square) & pieces(PieceType::Pawn, by)) return true;
+    if(Attacks::knight(square) & pieces(PieceType::Knight, by)) return true;
+    if(Attacks::king(square) & pieces(PieceType::King, by)) return true;
+    Bitboard queens = pieces(PieceType::Queen, by);
+    if(Attacks::rook(square, pieces()) & (pieces(PieceType::Rook, by) | queens)) return true;
+    return Attacks::bishop(square, pieces()) & (pieces(PieceType::Bishop, by) | queens);
+}
+
+Bitboard Board::attacks(PieceColor by, Bitboard occupied) const {
+    // pawns and sliders of the whole side at once, only knights and the king go square by square
+    Bitboard pawns = pieces(PieceType::Pawn, by);
+    Bitboard attacked = by == PieceColor::White ? Bitboards::shift<7>(pawns) | Bitboards::shift<9>(pawns)
+                                                : Bitboards::shift<-7>(pawns) | Bitboards::shift<-9>(pawns);
+    Bitboard queens = pieces(PieceType::Queen, by);
+    attacked |= Attacks::sliders(pieces(PieceType::Rook, by) | queens, pieces(PieceType::Bishop, by) | queens, occupied);
+    Bitboard knights = pieces(PieceType::Knight, by);
+    while(knights) attacked |= Attacks::knight(Square::fromIndexUnchecked(Bitboards::popLsb(knights)));
+    Bitboard kings = pieces(PieceType::King, by);
+    while(kings) attacked |= Attacks::king(Square::fromIndexUnchecked(Bitboards::popLsb(kings)));
+    return attacked;
+}
+
+Bitboard Board::attacks(PieceColor by) const {
+    return attacks(by, pieces());
+}
+
+bool Board::isPseudoLegal(const Move& move) const {
+    Square from = move.from();
+    Square to = move.to();
+    Bitboard occupied = pieces();
+    Bitboard own = pieces(turn());
+    if(!Bitboards::contains(own, from.index()) || Bitboards::contains(own, to.index())) return false;
+    PieceType type = position_.pieceOn(from).type();
+
+    // only pawns promote, and they have to once they reach the last rank
+    unsigned lastRank = turn() == PieceColor::White ? 7 : 0;
+    if(move.promotion().has_value() != (type == PieceType::Pawn && to.rank() == lastRank)) return false;
+
+    switch(type){
+        case PieceType::Pawn: {
+            int up = turn() == PieceColor::White ? 8 : -8;
+            // en passant needs the pawn that passed the square
+            Bitboard captures = pieces(!turn());
+            Square::Optional enPassant = enPassantSquare();
+            if(enPassant.has_value() && Bitboards::contains(pieces(PieceType::Pawn, !turn()), enPassant->index() - up))
+                captures |= Bitboards::squareBB(enPassant->index());
+            if(Bitboards::contains(Attacks::pawn(turn(), from) & captures, to.index())) return true;
+            if(Bitboards::contains(occupied, to.index())) return false;
+            if((int) to.index() == (int) from.index() + up) return true;
+            // a double step starts on the second rank and passes an empty square
+            unsigned startRank = turn() == PieceColor::White ? 1 : 6;
+            return from.rank() == startRank && (int) to.index() == (int) from.index() + 2 * up
+                && !Bitboards::contains(occupied, from.index() + up);
+        }
+        case PieceType::Knight: return Bitboards::contains(Attacks::knight(from), to.index());
+        case PieceType::Bishop: return Bitboards::contains(Attacks::bishop(from, occupied), to.index());
+        case PieceType::Rook: return Bitboards::contains(Attacks::rook(from, occupied), to.index());
+        case PieceType::Queen: return Bitboards::contains(Attacks::queen(from, occupied), to.index());
+        case PieceType::King: break;
     }
-    //if(kingIndex == std::nullopt) return false;
-    // get possible moves of all opposing pieces and store the move.to indices
-    std::vector<int> possibleOtherPiecesMovesIndices = std::vector<int>();
-    MoveVec moves = generatedMovesOtherColor;
-    //if(getGeneratedMovesOtherColor() == nullptr) return false;
-    //else moves = *getGeneratedMovesOtherColor();
-    for(Move move: moves) possibleOtherPiecesMovesIndices.push_back((int) move.to().index());
-    
-    // if king index in attackedindices => return true
-    if(std::find(possibleOtherPiecesMovesIndices.begin(), possibleOtherPiecesMovesIndices.end(), (int)* kingIndex) != possibleOtherPiecesMovesIndices.end())
-        return true;
-    return false;
+    if(Bitboards::contains(Attacks::king(from), to.index())) return true;
+
+    // castling, with the same rules as the generator
+    bool white = turn() == PieceColor::White;
+    if(!(from == (white ? Square::E1 : Square::E8)) || to.rank() != from.rank()) return false;
+    bool kingside = to.file() == from.file() + 2;
+    if(!kingside && to.file() + 2 != from.file()) return false;
+    CastlingRights right = white ? (kingside ? CastlingRights::WhiteKingside : CastlingRights::WhiteQueenside)
+                                 : (kingside ? CastlingRights::BlackKingside : CastlingRights::BlackQueenside);
+    Square rook = Square::fromCoordinatesUnchecked(kingside ? 7 : 0, from.rank());
+    Square kingPasses = Square::fromCoordinatesUnchecked((from.file() + to.file()) / 2, from.rank());
+    if(!castlingRightsHave(right) || !Bitboards::contains(pieces(PieceType::Rook, turn()), rook.index())) return false;
+    if(Attacks::between(from, rook) & occupied) return false;
+    return !isCheck() && !isSquareAttacked(kingPasses, !turn()) && !isSquareAttacked(to, !turn());
+}
+
+bool Board::isLegal(const Move& move) const {
+    Bitboard kings = pieces(PieceType::King, turn());
+    if(!kings) return true;
+    Square from = move.from();
+    Square to = move.to();
+    PieceType type = position_.pieceOn(from).type();
+
+    // the own king must not be attacked on the occupancy after the move, by anything but the captured piece
+    Bitboard occupied = (pieces() ^ Bitboards::squareBB(from.index())) | Bitboards::squareBB(to.index());
+    Bitboard captured = Bitboards::squareBB(to.index());
+    if(type == PieceType::Pawn && enPassantSquare().has_value() && to == *enPassantSquare()){
+        captured = Bitboards::squareBB(Square::fromCoordinatesUnchecked(to.file(), from.rank()).index());
+        occupied ^= captured;
+    }
+    Square kingSquare = type == PieceType::King ? to : Square::fromIndexUnchecked(Bitboards::lsb(kings));
+    return !(attackersTo(kingSquare, occupied) & pieces(!turn()) & ~captured);
+}
+
+Board::CheckInfo Board::checkInfo() const {
+    CheckInfo checks;
+    Bitboard kings = pieces(PieceType::King, !turn());
+    if(!kings) return checks;
+    checks.kingSquare = Square::fromIndexUnchecked(Bitboards::lsb(kings));
+
+    Bitboard occupied = pieces();
+    Bitboard own = pieces(turn());
+    checks.squares[(int) PieceType::Pawn] = Attacks::pawn(!turn(), checks.kingSquare);
+    checks.squares[(int) PieceType::Knight] = Attacks::knight(checks.kingSquare);
+    checks.squares[(int) PieceType::Bishop] = Attacks::bishop(checks.kingSquare, occupied);
+    checks.squares[(int) PieceType::Rook] = Attacks::rook(checks.kingSquare, occupied);
+    checks.squares[(int) PieceType::Queen] = checks.squares[(int) PieceType::Bishop] | checks.squares[(int) PieceType::Rook];
+
+    // an own piece alone between the enemy king and an own slider
+    Bitboard rooks = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishops = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+    Bitboard snipers = ((Attacks::rook(checks.kingSquare, Bitboards::Empty) & rooks)
+                     | (Attacks::bishop(checks.kingSquare, Bitboards::Empty) & bishops)) & own;
+    while(snipers){
+        Bitboard blockers = Attacks::between(checks.kingSquare, Square::fromIndexUnchecked(Bitboards::popLsb(snipers))) & occupied;
+        if(Bitboards::popCount(blockers) == 1) checks.discoverers |= blockers & own;
+    }
+    return checks;
+}
+
+bool Board::givesCheck(const Move& move) const {
+    return givesCheck(move, checkInfo());
 }
 
-bool Board::isStaleMate(MoveVec& generatedMovesOtherColor, std::optional< PieceColor > color){
-    (void) generatedMovesOtherColor;
-    //(void) color;
-    // set optional turn of board
-    PieceColor turnOfBoard = turn();
-    if(color != std::nullopt) turnOfBoard = (PieceColor)* color;
-    (void) turnOfBoard;
-
-    /* check if king is in check in current position */
-    /*if(isCheck(generatedMovesOtherColor)) return false;
-
-    // find king on board
-    int kingIndex = (int)* findKingIndex(turnOfBoard);
-    Board::MoveVec kingMoves;
-    pseudoLegalMovesFrom(*Square::fromIndex(kingIndex), kingMoves);
-    if(kingMoves.size() == 0) return false;
-    for(Move move: kingMoves){
-        makeMove(move);
-        Board::MoveVec otherPiecesMoves;
-        pseudoLegalMoves(otherPiecesMoves);
-        if(!isCheck(otherPiecesMoves, std::nullopt, !turn())) return false;
-        reverseMove(move);
+bool Board::givesCheck(const Move& move, const CheckInfo& checks) const {
+    if(!pieces(PieceType::King, !turn())) return false;
+    Square from = move.from();
+    Square to = move.to();
+    PieceType type = position_.pieceOn(from).type();
+    std::optional<PieceType> promotion = move.promotion();
+
+    // direct check from the target square, or a slider uncovered by leaving the line to the king
+    if(!promotion.has_value() && Bitboards::contains(checks.squares[(int) type], to.index())) return true;
+    if(Bitboards::contains(checks.discoverers, from.index())
+       && !Bitboards::contains(Attacks::line(checks.kingSquare, from), to.index())) return true;
+
+    // the remaining moves change more than one square, look at the king from the occupancy after the move
+    Bitboard occupied = (pieces() ^ Bitboards::squareBB(from.index())) | Bitboards::squareBB(to.index());
+    Bitboard queens = pieces(PieceType::Queen, turn());
+    Bitboard rooks = pieces(PieceType::Rook, turn()) | queens;
+    Bitboard bishops = pieces(PieceType::Bishop, turn()) | queens;
+
+    if(promotion.has_value()){
+        switch(*promotion){
+            case PieceType::Knight: return Bitboards::contains(Attacks::knight(to), checks.kingSquare.index());
+            case PieceType::Bishop: return Bitboards::contains(Attacks::bishop(to, occupied), checks.kingSquare.index());
+            case PieceType::Rook: return Bitboards::contains(Attacks::rook(to, occupied), checks.kingSquare.index());
+            default: return Bitboards::contains(Attacks::queen(to, occupied), checks.kingSquare.index());
+        }
+    }
+
+    // en passant also takes the captured pawn off its square, which can uncover a check
+    if(type == PieceType::Pawn && enPassantSquare().has_value() && to == *enPassantSquare()){
+        occupied ^= Bitboards::squareBB(Square::fromCoordinatesUnchecked(to.file(), from.rank()).index());
+        return (Attacks::rook(checks.kingSquare, occupied) & rooks) || (Attacks::bishop(checks.kingSquare, occupied) & bishops);
+    }
+
+    // castling: the rook lands next to the king, on the square the king passed
+    if(type == PieceType::King && (from.file() == to.file() + 2 || to.file() == from.file() + 2)){
+        Square rookFrom = Square::fromCoordinatesUnchecked(to.file() > from.file() ? 7 : 0, from.rank());
+        Square rookTo = Square::fromCoordinatesUnchecked((from.file() + to.file()) / 2, from.rank());
+        Bitboard rookMove = Bitboards::squareBB(rookFrom.index()) | Bitboards::squareBB(rookTo.index());
+        occupied ^= rookMove;
+        rooks ^= rookMove;
+        return (Attacks::rook(checks.kingSquare, occupied) & rooks) || (Attacks::bishop(checks.kingSquare, occupied) & bishops);
     }
-    //return true;*/
     return false;
 }
 
-bool Board::isCheckMate(MoveVec& generatedMovesBoardColor, MoveVec& generatedMovesOtherColor)
-{
-    //(void) color;
-    
-    /* check if king is in check in current position */
-    if(!isCheck(generatedMovesOtherColor)) return false;
-        
-    /* check if piece of same color can prevent the king being in check */
-    bool nonCheckMovePossible = false;
-    MoveVec originalOpposingColorMoves = generatedMovesOtherColor;
-    MoveVec movesOpposingColor = MoveVec();
-    // try every move you can make and check if any move is in check
-    for(Move move: generatedMovesBoardColor){
-        //std::cout << "my moves: ";
-        // make the move
-        makeMove(move);
-        //for(Move move: generatedMovesBoardColor) std::cout << move << ", ";
-        //std::cout << "\n ";
-        //NegaMax::printBoardWithPossibleMoves(*this, *getGeneratedMovesBoardColor());
-
-        // generate moves other can make as a response
-        pseudoLegalMoves(movesOpposingColor);
-        //std::cout << "other moves: " << move;
-        //for(Move move: movesOpposingColor) std::cout << move << ", ";
-        //std::cout << "\n ";
-        //NegaMax::printBoardWithPossibleMoves(*this, movesOpposingColor);
-        
-        //setGeneratedMovesOtherColor(std::make_shared<MoveVec>(movesOpposingColor));
-        generatedMovesOtherColor = movesOpposingColor;
-        //std::cout << "is check?: " << isCheck(generatedMovesOtherColor, std::nullopt, !turn());
-        if(!isCheck(generatedMovesOtherColor, std::nullopt, !turn())) nonCheckMovePossible = true;
-        reverseMove(move);
-        if(nonCheckMovePossible){
-            //setGeneratedMovesOtherColor(std::make_shared<MoveVec>(originalOpposingColorMoves));
-            generatedMovesOtherColor = originalOpposingColorMoves;
-            return false;
+// what move captures at first, with the occupancy once the mover and the captured piece have left and the
+// piece that now stands on the target square. castling captures nothing and leaves nothing to capture
+static int exchangeStart(const Board& board, const Move& move, Bitboard& occupied, std::optional<PieceType>& onTarget) {
+    Square from = move.from();
+    Square to = move.to();
+    PieceType mover = board.piece(from)->type();
+    occupied = board.pieces() ^ Bitboards::squareBB(from.index());
+    onTarget = std::nullopt;
+    if(move.type() == Move::Type::Castling || (mover == PieceType::King && (from.file() == to.file() + 2 || to.file() == from.file() + 2))) return 0;
+
+    onTarget = move.promotion().value_or(mover);
+    Piece::Optional captured = board.piece(to);
+    int value = captured.has_value() ? board.pieceValue(captured->type()) : 0;
+    if(mover == PieceType::Pawn && board.enPassantSquare().has_value() && to == *board.enPassantSquare()){
+        occupied ^= Bitboards::squareBB(Square::fromCoordinatesUnchecked(to.file(), from.rank()).index());
+        value = board.pieceValue(PieceType::Pawn);
+    }
+    if(move.promotion().has_value()) value += board.pieceValue(*move.promotion()) - board.pieceValue(PieceType::Pawn);
+    return value;
+}
+
+static constexpr PieceType ByValue[] = {
+    PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King
+};
+
+// the least valuable piece among attackers, which must not be empty
+static PieceType leastValuable(const Board& board, Bitboard attackers, Bitboard& piece) {
+    for(PieceType type : ByValue){
+        if(Bitboard ofType = attackers & board.pieces(type)){
+            piece = Bitboards::squareBB(Bitboards::lsb(ofType));
+            return type;
         }
-        movesOpposingColor.clear();
     }
-    generatedMovesOtherColor = originalOpposingColorMoves;
-    //setGeneratedMovesOtherColor(std::make_shared<MoveVec>(originalOpposingColorMoves));
-    return true;
+    piece = Bitboards::Empty;
+    return PieceType::King;
+}
+
+int Board::see(const Move& move) const {
+    Bitboard occupied;
+    std::optional<PieceType> onTarget;
+    // gain[d] is what the side making capture d has won if the exchange ends there
+    int gain[32];
+    gain[0] = exchangeStart(*this, move, occupied, onTarget);
+    if(!onTarget.has_value()) return 0;
+
+    Square to = move.to();
+    Bitboard rooks = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishops = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+    Bitboard attackers = attackersTo(to, occupied) & occupied;
+    PieceColor side = !piece(move.from())->color();
+    int depth = 0;
+    while(Bitboard own = attackers & pieces(side)){
+        Bitboard capturer;
+        PieceType type = leastValuable(*this, own, capturer);
+        // the king only takes when nothing can take it back
+        if(type == PieceType::King && (attackers & pieces(!side))) break;
+        depth++;
+        gain[depth] = pieceValue(*onTarget) - gain[depth - 1];
+        occupied ^= capturer;
+        attackers = (attackers | (Attacks::rook(to, occupied) & rooks) | (Attacks::bishop(to, occupied) & bishops)) & occupied;
+        onTarget = type;
+        side = !side;
+    }
+    // from the last capture back, each side stops recapturing when that would lose material
+    for(; depth > 0; depth--) gain[depth - 1] = - std::max(- gain[depth - 1], gain[depth]);
+    return gain[0];
+}
+
+bool Board::seeGe(const Move& move, int threshold) const {
+    Bitboard occupied;
+    std::optional<PieceType> onTarget;
+    // balance is how far the side to move is above threshold, negated whenever the side changes
+    int balance = exchangeStart(*this, move, occupied, onTarget) - threshold;
+    if(balance < 0) return false;
+    if(!onTarget.has_value()) return true;
+    // even losing the moved piece for nothing stays above threshold
+    balance = pieceValue(*onTarget) - balance;
+    if(balance <= 0) return true;
+
+    Square to = move.to();
+    Bitboard rooks = pieces(PieceType::Rook) | pieces(PieceType::Queen);
+    Bitboard bishops = pieces(PieceType::Bishop) | pieces(PieceType::Queen);
+    Bitboard attackers = attackersTo(to, occupied) & occupied;
+    PieceColor side = piece(move.from())->color();
+    // whether the side to move reaches threshold if the exchange ends now
+    bool result = true;
+    while(true){
+        side = !side;
+        Bitboard own = attackers & pieces(side);
+        if(!own) break;
+        result = !result;
+        Bitboard capturer;
+        PieceType type = leastValuable(*this, own, capturer);
+        // the king only takes when nothing can take it back
+        if(type == PieceType::King) return (attackers & pieces(!side)) ? !result : result;
+        // when taking this piece back does not pay off for the other side the exchange ends here
+        balance = pieceValue(type) - balance;
+        if(balance < (int) result) break;
+        occupied ^= capturer;
+        attackers = (attackers | (Attacks::rook(to, occupied) & rooks) | (Attacks::bishop(to, occupied) & bishops)) & occupied;
+    }
+    return result;
+}
+
+bool Board::isCheck(std::optional< PieceColor > color) const
+{
+    PieceColor turnOfBoard = color.value_or(turn());
+    Bitboard kings = pieces(PieceType::King, turnOfBoard);
+    if(!kings) return false;
+    return isSquareAttacked(Square::fromIndexUnchecked(Bitboards::lsb(kings)), !turnOfBoard);
+}
+
+bool Board::isStaleMate() const {
+    if(isCheck()) return false;
+    MoveVec moves;
+    legalMoves(moves);
+    return moves.empty();
+}
+
+bool Board::isCheckMate() const
+{
+    // only generate moves when the king is actually attacked
+    if(!isCheck()) return false;
+    MoveVec moves;
+    legalMoves(moves);
+    return moves.empty();
 }
 
 std::ostream& operator<<(std::ostream& os, const Board& board) {
@@ -595,19 +595,12 @@ std::ostream& operator<<(std::ostream& os, const Board& board) {
     //std::cout << "\n";
     for(int i = 7; i >= 0; i--){
         for(int j = 0; j < 8; j++){
-            //std::cout << "x: " << j << " y: " << i; 
-            if(board.pieceMap().count(i * 8 + j)){
-                std::shared_ptr<Piece> res = board.pieceMap().at(i * 8 + j);
-                os << " " << *res << " ";
-            }
+            Piece::Optional piece = board.piece(Square::fromCoordinatesUnchecked(j, i));
+            if(piece.has_value()) os << " " << *piece << " ";
             else os << " . ";
         }
         os << "\n";
     }
-    /*std::cout << "piecemap: \n" ;
-    for (auto const& [key, val] : board.pieceMap()){
-        std::cout << "key: " << key << " val: " << *val << " ";
-    }*/
     //std::cout << "\n \n \n" ;
     //std::cout << "\n \n \n" ;
     return os;
@@ -4,15 +4,19 @@
 #include "Piece.hpp"
 #include "Square.hpp"
 #include "Move.hpp"
+#include "MoveList.hpp"
 #include "CastlingRights.hpp"
+#include "Bitboard.hpp"
+#include "Zobrist.hpp"
+#include "Position.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <iosfwd>
 #include <vector>
-#include <memory>
-#include <map>
 #include <set>
-#include <stack>  
+#include <array>
 
 class ValueVisitor;
 
@@ -20,78 +24,120 @@ class Board {
 public:
 
     using Optional = std::optional<Board>;
-    using MoveVec = std::vector<Move>;
+    using MoveVec = MoveList;
 
     Board();
+    // a copy only takes the history of the moves made so far
+    Board(const Board& other);
+    Board& operator=(const Board& other);
 
     void setPiece(const Square& square, const Piece::Optional& piece);
     Piece::Optional piece(const Square& square) const;
     void setTurn(PieceColor turn);
     PieceColor turn() const;
-    std::map<int,std::shared_ptr<Piece>> pieceMap() const;
+    Bitboard pieces() const;
+    Bitboard pieces(PieceColor color) const;
+    Bitboard pieces(PieceType type) const;
+    Bitboard pieces(PieceType type, PieceColor color) const;
     void setCastlingRights(CastlingRights cr);
     void addCastlingRights(CastlingRights cr);
     void removeCastlingRights(CastlingRights cr);
     CastlingRights castlingRights() const;
     void setEnPassantSquare(Square::Optional square);
     Square::Optional enPassantSquare() const;
+    void setHalfmoveClock(unsigned halfmoveClock);
+    unsigned halfmoveClock() const;
+
+    // hash of the position, kept up to date by every change to the board
+    Zobrist::Key key() const;
+    Zobrist::Key computeKey() const;
+
+    // the position without its history, setPosition does not touch the history used by reverseMove
+    const Position& position() const;
+    void setPosition(const Position& position);
     
     void makeMove(const Move& move);
     void reverseMove(const Move& move);
 
-    void updateCastlingRights(Piece pieceToMove, const Move& move);
+    void updateCastlingRights(const Move& move);
     bool castlingRightsHave(CastlingRights cr) const;
-    bool pieceInBetween(Square square1, Square square2);
     
-    MoveVec moves;
     void pseudoLegalMoves(MoveVec& moves) const;
     void pseudoLegalMovesFrom(const Square& from, MoveVec& moves) const;
+    void legalMoves(MoveVec& moves) const;
     
     void printPossibleMoves(const Board& board, std::set<Move> generatedMoves) const;
     
     int pieceValue(PieceType type) const;
-    int evaluate(MoveVec& generatedMovesBoardColor, MoveVec& generatedMovesOtherColor);
-        
-    MoveVec orderMoves(MoveVec& generatedMoves);
-    bool sortByScore(Move& move1, Move& move2);
-    
-    bool isCheck(MoveVec& generatedMovesOtherColor, std::optional< int > kingIndex = std::nullopt, std::optional< PieceColor > color = std::nullopt);
-    bool isCheckMate(MoveVec& generatedMovesBoardColor, MoveVec& generatedMovesOtherColor);
-    bool isStaleMate(MoveVec& generatedMovesOtherColor, std::optional< PieceColor > color = std::nullopt);
-    
-    std::stack<std::pair<Piece,Move>> captures;
-    std::stack<std::pair<PieceType,Move>> promotions;
-    std::stack<std::pair<Move,Move>> castlings;
-    std::stack<std::pair<Square,Move>> enPassantSquares;
+    int evaluate();
     
-    bool whiteKingHasMoved = false;
-    bool whiteLeftRookHasMoved = false;
-    bool whiteRightRookHasMoved = false;
-    
-    bool blackKingHasMoved = false;
-    bool blackLeftRookHasMoved = false;
-    bool blackRightRookHasMoved = false;
+    // pieces of both colors attacking square, sliders are blocked by the given occupancy
+    Bitboard attackersTo(Square square, Bitboard occupied) const;
+    Bitboard attackersTo(Square square) const;
+    bool isSquareAttacked(Square square, PieceColor by) const;
+    // every square attacked by a color, sliders are blocked by the given occupancy
+    Bitboard attacks(PieceColor by, Bitboard occupied) const;
+    Bitboard attacks(PieceColor by) const;
+
+    // whether move, maybe from another position, can be made here apart from leaving the own king in check.
+    // castling is fully checked. The en passant and castling flags are not required, as for makeMove
+    bool isPseudoLegal(const Move& move) const;
+    // whether a pseudo-legal move keeps the own king out of check
+    bool isLegal(const Move& move) const;
+
+    // how the side to move can give check, computed once per node
+    struct CheckInfo {
+        // squares from which a piece of each type attacks the enemy king, indexed by PieceType
+        Bitboard squares[6] = {};
+        // own pieces that uncover a check by an own slider when they leave the line to the enemy king
+        Bitboard discoverers = Bitboards::Empty;
+        Square kingSquare = Square::A1;
+    };
+    // without an enemy king all masks are empty
+    CheckInfo checkInfo() const;
+    // whether a legal move checks the enemy king, answered without making it
+    bool givesCheck(const Move& move) const;
+    bool givesCheck(const Move& move, const CheckInfo& checks) const;
+
+    // static exchange evaluation: the material the side to move wins with move when both sides keep
+    // recapturing on its target square with their least valuable piece for as long as that pays off.
+    // pins are ignored and no move is made, sliders behind a capturing piece join in
+    int see(const Move& move) const;
+    // whether see(move) >= threshold, stopping as soon as the answer is known
+    bool seeGe(const Move& move, int threshold) const;
+
+    // whether the king of color (the side to move by default) is attacked
+    bool isCheck(std::optional< PieceColor > color = std::nullopt) const;
+    bool isCheckMate() const;
+    bool isStaleMate() const;
     
-    static bool pieceInCapturingZone(Board board, int index);
+    static bool pieceInCapturingZone(const Board& board, int index);
     
     std::vector<int> findPieceIndices(PieceType pieceType, PieceColor color) const;
     std::optional<int> findKingIndex(PieceColor color) const;
     std::vector<int> getMoveToIndices(MoveVec& moves) const;
     std::vector<int> calculateIntersection(std::vector<int>& vector1, std::vector<int>& vector2);
     
-    void setGeneratedMovesBoardColor(std::shared_ptr<MoveVec> ptr);
-    std::shared_ptr<MoveVec> getGeneratedMovesBoardColor() const;
-    void setGeneratedMovesOtherColor(std::shared_ptr<MoveVec> ptr);
-    std::shared_ptr<MoveVec> getGeneratedMovesOtherColor() const;
-    
 private:
-    std::map<int,std::shared_ptr<Piece>> pieceMap_;
-    PieceColor turn_;
-    std::shared_ptr<std::optional<Piece>> piece_;
-    Square::Optional enPassantSquare_;
-    CastlingRights castlingright_;
-    std::shared_ptr<MoveVec> generatedMovesBoardColor;
-    std::shared_ptr<MoveVec> generatedMovesOtherColor;
+    Position position_;
+
+    // everything reverseMove can not derive from the move itself, saved by makeMove
+    struct StateInfo {
+        Zobrist::Key key;
+        std::uint16_t halfmoveClock;
+        CastlingRights castlingRights;
+        Square::Optional enPassantSquare;
+        std::uint8_t capturedPiece;
+    };
+
+    // one entry per move made, history_[ply_ - 1] belongs to the last move.
+    // it grows when full, entries from ply_ on are left over from moves taken back
+    std::vector<StateInfo> history_;
+    std::size_t ply_;
+
+    // takes back the pieces moved by a move of color Us, reverseMove restores the rest of the state
+    template<PieceColor Us>
+    void reverseMove(const Move& move, const StateInfo& state);
 };
 
 std::ostream& operator<<(std::ostream& os, const Board& board);
@@ -2,8 +2,9 @@
 #define CHESS_ENGINE_CASTLINGRIGHTS_HPP
 
 #include <iosfwd>
+#include <cstdint>
 
-enum class CastlingRights {
+enum class CastlingRights : std::uint8_t {
     None           = 0,
     WhiteKingside  = 1 << 0,
     WhiteQueenside = 1 << 1,
@@ -2,7 +2,10 @@
 #include "PrincipalVariation.hpp"
 #include "NegaMax.hpp"
 #include "TimeInfo.hpp"
+#include "Attacks.hpp"
 #include <iostream>
+#include <cstdlib>
+#include <string>
 
 
 std::string ChessEngine::name() const {
@@ -17,8 +20,44 @@ std::string ChessEngine::author() const {
     return "Sébastien Raeymaekers";
 }
 
+std::vector<std::string> ChessEngine::options() const {
+    std::string sliderAttacks = "name SliderAttacks type combo default ";
+    sliderAttacks += Attacks::defaultIndexing() == Attacks::Indexing::Pext ? "Pext" : "Magic";
+    sliderAttacks += " var Magic";
+    if(Attacks::pextSupported()) sliderAttacks += " var Pext";
+    std::string hash = "name Hash type spin default " + std::to_string(NegaMax::DefaultHashMegabytes) + " min 1 max 4096";
+    std::string threads = "name Threads type spin default 1 min 1 max 256";
+    std::string parallelSearch = "name ParallelSearch type combo default LazySmp var LazySmp var YBW";
+    return {sliderAttacks, hash, threads, parallelSearch};
+}
+
+bool ChessEngine::setOption(const std::string& name, const std::string& value) {
+    if(name == "SliderAttacks"){
+        if(value == "Magic") return Attacks::setIndexing(Attacks::Indexing::Magic);
+        if(value == "Pext") return Attacks::setIndexing(Attacks::Indexing::Pext);
+    }
+    if(name == "ParallelSearch"){
+        if(value == "LazySmp") NegaMax::setParallelSearch(NegaMax::ParallelSearch::LazySmp);
+        else if(value == "YBW") NegaMax::setParallelSearch(NegaMax::ParallelSearch::YoungBrothersWait);
+        else return false;
+        return true;
+    }
+    if(name == "Hash" || name == "Threads"){
+        // megabytes of transposition table or number of search threads
+        char* end = nullptr;
+        unsigned long number = std::strtoul(value.c_str(), &end, 10);
+        if(value.empty() || *end != '\0' || number < 1) return false;
+        if(name == "Hash" && number <= 4096) NegaMax::setHashSize(number);
+        else if(name == "Threads" && number <= 256) NegaMax::setThreads((unsigned) number);
+        else return false;
+        return true;
+    }
+    return false;
+}
+
 void ChessEngine::newGame() {
-    return;
+    // results from the previous game would only take up space
+    NegaMax::clearHash();
 }
 
 PrincipalVariation ChessEngine::pv(const Board& board, const TimeInfo::Optional& timeInfo) {
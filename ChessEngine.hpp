@@ -16,6 +16,9 @@ public:
 
     void newGame();
     PrincipalVariation pv(const Board& board, const TimeInfo::Optional& timeInfo = std::nullopt);
+
+    std::vector<std::string> options() const;
+    bool setOption(const std::string& name, const std::string& value);
 };
 
 
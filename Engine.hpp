@@ -6,6 +6,7 @@
 #include "TimeInfo.hpp"
 
 #include <string>
+#include <vector>
 
 class Engine {
 public:
@@ -21,6 +22,18 @@ public:
         const Board& board,
         const TimeInfo::Optional& timeInfo = std::nullopt
     ) = 0;
+
+    // UCI options as announced after "uci", without the leading "option"
+    virtual std::vector<std::string> options() const {
+        return {};
+    }
+
+    // returns false if the option does not exist or the value is not accepted
+    virtual bool setOption(const std::string& name, const std::string& value) {
+        (void) name;
+        (void) value;
+        return false;
+    }
 };
 
 #endif
@@ -104,6 +104,15 @@ static bool parseEnPassantSquare(const std::string& ep, Board& board) {
     }
 }
 
+static bool parseHalfmoveClock(const std::string& halfmove, Board& board) {
+    if (halfmove.find_first_not_of("0123456789") != std::string::npos || halfmove.size() > 4) {
+        return false;
+    }
+
+    board.setHalfmoveClock(std::stoul(halfmove));
+    return true;
+}
+
 Board::Optional Fen::createBoard(std::istream& fenStream) {
     auto placement = nextField(fenStream);
 
@@ -153,6 +162,10 @@ Board::Optional Fen::createBoard(std::istream& fenStream) {
         return std::nullopt;
     }
 
+    if (!parseHalfmoveClock(halfmove, board)) {
+        return std::nullopt;
+    }
+
     auto fullmove = nextField(fenStream);
 
     if (fullmove.empty()) {
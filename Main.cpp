@@ -2,10 +2,13 @@
 #include "EngineFactory.hpp"
 #include "Fen.hpp"
 #include "Engine.hpp"
+#include "Bench.hpp"
+#include "Perft.hpp"
 
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <string>
 
 int main(int argc, char* argv[]) {
     auto engine = EngineFactory::createEngine();
@@ -15,7 +18,60 @@ int main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
-    if (argc > 1) {
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        // bench [depth] [--threads <n>], with more than one thread also the Lazy SMP and YBW time to depth
+        auto depth = argc > 2 ? std::atoi(argv[2]) : 3;
+        auto threads = 1u;
+
+        if (argc > 4 && std::string(argv[3]) == "--threads") {
+            threads = (unsigned) std::atoi(argv[4]);
+        }
+
+        Bench::compareMoveMaking(std::cout, depth);
+
+        if (threads > 1) {
+            Bench::timeToDepth(std::cout, depth, threads);
+        }
+    } else if (argc > 2 && std::string(argv[1]) == "perft") {
+        // perft <depth> [--threads <n>] [--hash <mb>] [--scaling] [fen], the FEN may be one argument or separate fields.
+        // --scaling also counts on one thread and reports the speedup instead of the nodes per root move
+        auto depth = std::atoi(argv[2]);
+        auto threads = 1u;
+        auto hashMegabytes = std::size_t(0);
+        auto scaling = false;
+        auto fen = std::string();
+
+        for (auto i = 3; i < argc; i++) {
+            auto arg = std::string(argv[i]);
+
+            if (arg == "--threads" && i + 1 < argc) {
+                threads = (unsigned) std::atoi(argv[++i]);
+            } else if (arg == "--hash" && i + 1 < argc) {
+                hashMegabytes = (std::size_t) std::atoll(argv[++i]);
+            } else if (arg == "--scaling") {
+                scaling = true;
+            } else {
+                fen += (fen.empty() ? "" : " ") + arg;
+            }
+        }
+
+        if (fen.empty()) {
+            fen = Fen::StartingPos;
+        }
+
+        auto board = Fen::createBoard(fen);
+
+        if (!board.has_value()) {
+            std::cerr << "Parsing FEN failed\n";
+            return EXIT_FAILURE;
+        }
+
+        if (scaling) {
+            Bench::perftScaling(std::cout, board.value(), depth, threads, hashMegabytes);
+        } else {
+            Perft::divide(board.value(), depth, std::cout, threads, hashMegabytes);
+        }
+    } else if (argc > 1) {
         auto fen = argv[1];
         auto board = Fen::createBoard(fen);
 
@@ -1,18 +1,33 @@
 #include "Move.hpp"
-#include "Board.hpp"
 
 #include <ostream>
 #include <iostream>
-#include <memory>
 #include <algorithm>
-#include "NegaMax.hpp"
+#include <cassert>
+#include <type_traits>
+
+static_assert(sizeof(Move) == 2, "Move should be packed into 16 bits");
+static_assert(std::is_trivially_copyable<Move>::value, "Move should be trivially copyable");
+
+static constexpr std::uint16_t SquareMask = 0x3F;
+static constexpr std::uint16_t PromotionShift = 12;
+static constexpr std::uint16_t TypeMask = 3 << 14;
 
 Move::Move(const Square& from, const Square& to,
            const std::optional<PieceType>& promotion)
 {
-    from_ = std::make_shared<Square>(from);
-    to_ = std::make_shared<Square>(to);
-    promotion_ = promotion;
+    data_ = (std::uint16_t) (from.index() | (to.index() << 6));
+    if(promotion.has_value()){
+        // only knight, bishop, rook and queen fit in the two promotion bits
+        assert(*promotion != PieceType::Pawn && *promotion != PieceType::King);
+        data_ |= (std::uint16_t) Type::Promotion;
+        data_ |= (std::uint16_t) (((int) *promotion - (int) PieceType::Knight) << PromotionShift);
+    }
+}
+
+Move::Move(const Square& from, const Square& to, Type type)
+{
+    data_ = (std::uint16_t) (from.index() | (to.index() << 6) | (std::uint16_t) type);
 }
 
 Move::Optional Move::fromUci(const std::string& uci) {
@@ -22,90 +37,58 @@ Move::Optional Move::fromUci(const std::string& uci) {
     if(!from.has_value() || !to.has_value()) return std::nullopt;
     if(uci.length() == 5){
         std::optional<PieceType> promotion = Piece::charToPieceType(uci[4]);
-        if(!promotion.has_value()) return std::nullopt;
+        if(!promotion.has_value() || promotion == PieceType::Pawn || promotion == PieceType::King) return std::nullopt;
         return Move((Square) *from, (Square) *to, promotion);
     }
     return Move((Square) *from, (Square) *to);
 }
 
+Move Move::fromRaw(std::uint16_t raw) {
+    Move move;
+    move.data_ = raw;
+    return move;
+}
+
 Square Move::from() const {
-    return *from_.get();
+    return Square::fromIndexUnchecked(data_ & SquareMask);
 }
 
 Square Move::to() const {
-    return *to_.get();
+    return Square::fromIndexUnchecked((data_ >> 6) & SquareMask);
 }
 
 std::optional<PieceType> Move::promotion() const {
-    return promotion_;
+    if(type() != Type::Promotion) return std::nullopt;
+    return (PieceType) ((int) PieceType::Knight + ((data_ >> PromotionShift) & 3));
 }
 
-int Move::getScore(){
-    return score_;
+Move::Type Move::type() const {
+    return (Type) (data_ & TypeMask);
 }
 
-void Move::setScore(int score){
-    score_ = score;
+std::uint16_t Move::raw() const {
+    return data_;
 }
 
-int Move::score(Board board, Piece movePiece, std::optional<Piece> capturedPiece){
-    int score = 0;
-
-    // Capturing valuable pieces with less valuable ones gives a higher score.
-    if(capturedPiece != std::nullopt && board.pieceMap().count(to().index())){
-        Piece capturedPiece = *(board.pieceMap().at(to().index()));
-        score = score + board.pieceValue(capturedPiece.type()) + (board.pieceValue(capturedPiece.type()) - board.pieceValue(movePiece.type()));
-    }
-    
-    // Causing a check gives a higher score
-    Board::MoveVec generatedMovesOtherColor = Board::MoveVec();
-    NegaMax::generatePseudoLegalMoves(board, generatedMovesOtherColor, true, std::nullopt);
-    if(board.isCheck(generatedMovesOtherColor)) score = score + 1000;
-    
-    /*
-    // Moving to square which is in range of opposing piece gives lower score.
-    for(auto const& [key, val] : board.pieceMap()){ // For all pieces
-        Piece piece = (*val);
-        if(piece.color() != movePiece.color()){ // If piece has other color
-            Board::MoveVec generatedMoves;
-            board.pseudoLegalMovesFrom(to(), generatedMoves); // Generate all its moves
-            std::vector<Square> attackingSquares = std::vector<Square>(); // Collect squares they land on
-            for(Move move: generatedMoves){
-                attackingSquares.push_back(move.to());
-            } // Check if move.to is in squares they land on
-            if (std::find(attackingSquares.begin(), attackingSquares.end(), to()) != attackingSquares.end()) {
-                score = score - board.pieceValue(movePiece.type());
-            }
-        }
+std::ostream& operator<<(std::ostream& os, const Move& move) {
+    os << move.from() << move.to();
+    if(move.promotion().has_value()){
+        // promotion pieces are written as their lower case (black) symbol
+        os << Piece(PieceColor::Black, *move.promotion());
     }
-    //score_ = score;*/
-    return score;
+    return os;
 }
 
-std::ostream& operator<<(std::ostream& os, const Move& move) {
-    if (!move.promotion().has_value()) 
-        return os << move.from() << move.to();
-    else if(move.promotion() == PieceType::Pawn) 
-        return os << move.from() << move.to() << 'p';
-    else if(move.promotion() == PieceType::Knight) 
-        return os << move.from() << move.to() << 'n';
-    else if(move.promotion() == PieceType::Bishop) 
-        return os << move.from() << move.to() << 'b';
-    else if(move.promotion() == PieceType::Rook) 
-        return os << move.from() << move.to() << 'r';
-    else if(move.promotion() == PieceType::Queen) 
-        return os << move.from() << move.to() << 'q';
-    else 
-        return os << move.from() << move.to() << 'k';
+// from, to and promotion bits, without the en passant and castling flags
+static std::uint16_t identity(const Move& move) {
+    if(move.type() == Move::Type::Promotion) return move.raw();
+    return move.raw() & 0x0FFF;
 }
 
-
 bool operator<(const Move& lhs, const Move& rhs) {
-    return lhs.from().index() + lhs.to().index() < rhs.from().index() + rhs.to().index();
-    //return lhs.getScore() < rhs.getScore(); (results in failed promotion tests)
+    return identity(lhs) < identity(rhs);
 }
 
 bool operator==(const Move& lhs, const Move& rhs) {
-    return lhs.to() == rhs.to() && lhs.from() == rhs.from() && lhs.promotion() == rhs.promotion();
-    //return lhs.getScore() == rhs.getScore(); (results in failed promotion tests)
+    return identity(lhs) == identity(rhs);
 }
@@ -4,43 +4,51 @@
 #include "Square.hpp"
 #include "Piece.hpp"
 
+#include <cstdint>
 #include <iosfwd>
 #include <optional>
 #include <string>
-#include <memory>
-
-class Board;
 
+// A move packed into 16 bits: bits 0-5 hold the from index, bits 6-11 the to index,
+// bits 12-13 the promotion piece (knight, bishop, rook or queen) and bits 14-15 the move type.
 class Move {
 public:
 
     using Optional = std::optional<Move>;
 
+    enum class Type : std::uint16_t {
+        Normal    = 0 << 14,
+        Promotion = 1 << 14,
+        EnPassant = 2 << 14,
+        Castling  = 3 << 14
+    };
+
     Move(const Square& from, const Square& to,
          const std::optional<PieceType>& promotion = std::nullopt);
+    Move(const Square& from, const Square& to, Type type);
 
     static Optional fromUci(const std::string& uci);
+    // the move packed by raw(), for tables that store moves in 16 bits
+    static Move fromRaw(std::uint16_t raw);
 
     Square from() const;
     Square to() const;
     std::optional<PieceType> promotion() const;
-    
-    int score(Board board, Piece movePiece, std::optional<Piece> capturedPiece = std::nullopt);
-    
-    int getScore();
-    void setScore(int score);
-    int score_;
-    bool captureMove;
-    
+    Type type() const;
+    std::uint16_t raw() const;
+
 private:
-    std::shared_ptr<Square> from_;
-    std::shared_ptr<Square> to_;
-    std::optional<PieceType> promotion_;
+    // only for the uninitialized storage of MoveList
+    Move() = default;
+    friend class MoveList;
+
+    std::uint16_t data_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Move& move);
 
 // Needed for std::map, std::set
+// Both compare from, to and promotion only: en passant and castling are implied by the board.
 bool operator<(const Move& lhs, const Move& rhs);
 bool operator==(const Move& lhs, const Move& rhs);
 
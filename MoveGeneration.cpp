@@ -1,338 +1,230 @@
 #include "MoveGeneration.hpp"
-
-#include <ostream>
-#include <cassert>
-#include <cmath>
-#include <memory>
-#include <vector>
-#include <iostream>
+#include "Attacks.hpp"
 
 void MoveGeneration::generatePseudoLegalMoves(const Board& board, MoveVec& moves, const std::optional<Square>& from)
 {
-    if(from == std::nullopt){
-        for (auto const& [key, val] : board.pieceMap()){
-            Square startSquare = (Square)* Square::fromIndex(key);
-            Piece piece = *val;
-            if(piece.color() == board.turn()) generatePieceMoves(board, startSquare, piece, moves);
-        }
-    }
-    else {
-            Square startSquare = (Square)* from;
-            try {
-                Piece piece = (Piece)* board.pieceMap().at(startSquare.index());
-                generatePieceMoves(board, startSquare, piece, moves);
-            } catch(const std::exception& e) {}
-    }
+    Bitboard fromMask = from.has_value() ? Bitboards::squareBB(from->index()) : ~Bitboards::Empty;
+    if(board.turn() == PieceColor::White) generate<PieceColor::White, false>(board, moves, GenType::All, fromMask);
+    else generate<PieceColor::Black, false>(board, moves, GenType::All, fromMask);
 }
 
-void MoveGeneration::generatePieceMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves){
-    switch(piece.type()){
-        case PieceType::Pawn:
-            generatePawnMoves(board, startSquare, piece, moves);
-            break;
-        case PieceType::King:
-            generateKingMoves(board, startSquare, piece, moves);
-            break;
-        case PieceType::Queen:
-            generateQueenMoves(board, startSquare, piece, moves);
-            break;
-        case PieceType::Rook:
-            generateRookMoves(board, startSquare, piece, moves);
-            break;
-        case PieceType::Knight:
-            generateKnightMoves(board, startSquare, piece, moves);
-            break;
-        case PieceType::Bishop:
-            generateBishopMoves(board, startSquare, piece, moves);
-            break;
-    }
+void MoveGeneration::generateLegalMoves(const Board& board, MoveVec& moves, GenType type) {
+    if(board.turn() == PieceColor::White) generate<PieceColor::White, true>(board, moves, type, ~Bitboards::Empty);
+    else generate<PieceColor::Black, true>(board, moves, type, ~Bitboards::Empty);
 }
 
-//OK
-void MoveGeneration::generatePawnMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves) {
-    // define moveOffsetDirections.
-    std::tuple<int,int> moveOffsetsBlack[4] = {{0,-1},{0,-2},{-1,-1},{1,-1}};
-    std::tuple<int,int> moveOffsetsWhite[4] = {{0,1},{0,2},{-1,1},{1,1}};
+Bitboard MoveGeneration::checkers(const Board& board) {
+    Bitboard kings = board.pieces(PieceType::King, board.turn());
+    if(!kings) return Bitboards::Empty;
+    Square kingSquare = Square::fromIndexUnchecked(Bitboards::lsb(kings));
+    return board.attackersTo(kingSquare, board.pieces()) & board.pieces(!board.turn());
+}
 
-    std::tuple<int,int>* moveOffsets;
-    if(piece.color() == PieceColor::Black) moveOffsets = moveOffsetsBlack;
-    else moveOffsets = moveOffsetsWhite;
-    
-    // loop over moveOffsets.
-    for(int i = 0; i < 4; i++){
-        // check weater they return a valid Square by calling index using moveOffsets.
-        Square::Optional targetSquareOpt = Square::fromCoordinates(startSquare.file()+std::get<0>(moveOffsets[i]),
-                                                                startSquare.rank()+std::get<1>(moveOffsets[i]));
-        if(targetSquareOpt == std::nullopt) continue;
-        Square targetSquare = (Square)* targetSquareOpt;
-        
-        // check if diagonal moves possible
-        if(i > 1){
-            // check if other piece on targetSquare. If so move on it.
-            Piece::Optional otherPiece = board.piece(targetSquare);
-            if(otherPiece == std::nullopt) continue;
-            if(piece.color() != ((Piece)* otherPiece).color()){
-                // check promotion;
-                if((targetSquare.rank() == 0 && piece.color() == PieceColor::Black) || (targetSquare.rank() == 7 && piece.color() == PieceColor::White))
-                    moves.push_back(Move(startSquare,targetSquare,PieceType::Queen));
-                else moves.push_back(Move(startSquare,targetSquare));
-            }
-        }
-        
-        // check if vertical moves possible
-        if(i < 2){
-            // check if other piece on targetSquare. If so move blocked.
-            Piece::Optional otherPiece = board.piece(targetSquare);
-            if(otherPiece != std::nullopt) continue;
-            // if 1 vertical move OK
-            if(i == 0){
-                // check promotion
-                if((targetSquare.rank() == 0 && piece.color() == PieceColor::Black) || (targetSquare.rank() == 7 && piece.color() == PieceColor::White))
-                    moves.push_back(Move(startSquare,targetSquare,PieceType::Queen));
-                else moves.push_back(Move(startSquare,targetSquare));
-            }
-            // if 2 vertical moves at once only OK when rank == 1 and PieceColor is White or when rank == 6 and PieceColor is Black. (promotion not possible)
-            // and if no piece blocking
-            else {
-                if(((piece.color() == PieceColor::White && startSquare.rank() == 1) || (piece.color() == PieceColor::Black && startSquare.rank() == 6))
-                    && !board.pieceMap().count(targetSquare.index()+(std::get<1>(moveOffsets[0])*(-8))))
-                    moves.push_back(Move(startSquare,targetSquare));
-            }
-        }
-    }
-    
-    // check for en passant OK
-    //check adjacent square
-    for(int verticalMove = -1; verticalMove < 2; verticalMove+=2){
-        // check if there is a pawn of opposing color next to you
-        Square::Optional adjacentSquareOpt = Square::fromCoordinates(startSquare.file()+verticalMove, startSquare.rank());
-        if(adjacentSquareOpt == std::nullopt) continue;
-        Square adjacentSquare = (Square)* adjacentSquareOpt;
-        
-        Piece::Optional adjacentPieceOpt = board.piece(adjacentSquare);
-        if(adjacentPieceOpt == std::nullopt) continue;
-        Piece adjacentPiece = (Piece)* adjacentPieceOpt;
-        
-        if(adjacentPiece.color() == piece.color() || adjacentPiece.type() != PieceType::Pawn) continue;
-        
-        // check if capturing pawn has advanced exactly three ranks
-        if((piece.color() == PieceColor::White && startSquare.rank() != 4) || (piece.color() == PieceColor::Black && startSquare.rank() != 3)) continue;
-        
-        // check if previous move was where adjacent pawn moved two squares => i.e. check if enPassantSquare is adjacentSquare.
-        Square::Optional enPassantSquareOpt = board.enPassantSquare();
-        if(enPassantSquareOpt == std::nullopt) continue;
-        //Square enPassantSquare = (Square)* enPassantSquareOpt;
-        //if(!(enPassantSquare == adjacentSquare)) continue;
-        
-        // calculate move diagonal offset of en passant
-        int diagonalOffset;
-        if(piece.color() == PieceColor::Black) diagonalOffset = -8+verticalMove;
-        else diagonalOffset = 8+verticalMove;
-        Square::Optional targetSquare = Square::fromIndex(startSquare.index()+diagonalOffset);
-        if(targetSquare == std::nullopt) continue;
-        moves.push_back(Move(startSquare,(Square)* targetSquare));
-    }
+void MoveGeneration::serializeMoves(Square startSquare, Bitboard targets, MoveVec& moves) {
+    while(targets) moves.push_back(Move(startSquare, Square::fromIndexUnchecked(Bitboards::popLsb(targets))));
+}
+
+void MoveGeneration::generatePromotions(Square startSquare, Square targetSquare, MoveVec& moves) {
+    for(PieceType promotion : {PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight})
+        moves.push_back(Move(startSquare,targetSquare,promotion));
 }
 
-void MoveGeneration::generateKingMoves(Board board, Square startSquare, Piece piece, MoveVec& moves) {
-    // define moveOffsetDirections.
-    int moveOffsets[8] = {-1,1,-8,8,-7,7,-9,9};
-    int numberOffSquaresToEdge[8] = {(int) startSquare.file(), (int) (7-startSquare.file()), (int) startSquare.rank(), (int) (7-startSquare.rank()),
-        std::min((int) (7-startSquare.file()), (int) startSquare.rank()),
-        std::min((int) startSquare.file(), (int) (7-startSquare.rank())),
-        std::min((int) startSquare.file(), (int) startSquare.rank()),
-        std::min((int) (7-startSquare.rank()), (int) (7-startSquare.file()))
+template<PieceColor Us, bool Legal>
+void MoveGeneration::generate(const Board& board, MoveVec& moves, GenType type, Bitboard fromMask) {
+    constexpr PieceColor Them = !Us;
+    Bitboard occupied = board.pieces();
+    Bitboard own = board.pieces(Us);
+    Bitboard enemies = board.pieces(Them);
+    Bitboard kings = board.pieces(PieceType::King, Us);
+
+    // without a king nothing can be left in check, so its moves are generated as if pseudo-legal
+    bool checkKing = Legal && kings;
+    Square kingSquare = Square::fromIndexUnchecked(kings ? Bitboards::lsb(kings) : 0);
+    Bitboard checkers = checkKing ? board.attackersTo(kingSquare, occupied) & enemies : Bitboards::Empty;
+
+    // squares pieces other than pawns may move to for this type
+    Bitboard typeTargets = ~own;
+    if(type == GenType::Captures) typeTargets = enemies;
+    else if(type == GenType::Quiets || type == GenType::QuietChecks) typeTargets = ~occupied;
+
+    // quiet checks land on a checking square of the moving piece or uncover a check by leaving the line to the king
+    bool checksOnly = type == GenType::QuietChecks;
+    Board::CheckInfo checks = checksOnly ? board.checkInfo() : Board::CheckInfo();
+    auto checkTargets = [&](Square from, Bitboard pieceChecks){
+        if(!checksOnly) return ~Bitboards::Empty;
+        if(Bitboards::contains(checks.discoverers, from.index())) pieceChecks |= ~Attacks::line(checks.kingSquare, from);
+        return pieceChecks;
     };
-    
-    // loop over all offset directions.
-    for(int i = 0; i < 8; i++){
-        // loop over all positions of this direction.
-        for(int j = 0; j < numberOffSquaresToEdge[i]; j++){
-            // check weater they return a valid Square by calling index using moveOffsets.
-            Square::Optional targetSquare = Square::fromIndex(startSquare.index()+moveOffsets[i]*(j+1));  
-            if(targetSquare == std::nullopt) continue;
-            // check if move to targetSquare results in a check.
-            //if(board.inCheck((Square)* targetSquare)) continue;
-            // check if other piece on targetSquare. If same color piece continue, else capture it.
-            Piece::Optional otherPiece = board.piece((Square)* targetSquare);
-            if(otherPiece != std::nullopt){
-                // if enemy piece has been encountered capture and break search in this direction. else just break.
-                if(piece.color() != ((Piece)* otherPiece).color()){
-                moves.push_back(Move(startSquare,(Square)* targetSquare));
-                }
-                break;
-            }
-            moves.push_back(Move(startSquare,(Square)* targetSquare));
-            break;
-        }
-    }
-    /*
-    // check castling positions
-    // if board has no castling rights => return
-    if (board.castlingRightsHave(CastlingRights::None)) return;
-    // if color has no castling rights => return
-    if((board.turn() == PieceColor::White && board.castlingRightsHave(CastlingRights::Black))
-        || (board.turn() == PieceColor::Black && board.castlingRightsHave(CastlingRights::White))) return;
-    
-    // check if there is a piece between king and rook
-    int kingIndices[2] = {4, 60};
-    int rankOffsets[2] = {4,3};
-    int rankStartCount[2] = {-1,1};
-    int rankEndCount[2] = {3,2};
-    int i = 0;
-    if(piece.color() == PieceColor::Black) i = 1;
-    //std::cout << "CastlingRights: " << board.castlingRights() << "--------------------------------" << '\n';
-    if (board.castlingRightsHave(CastlingRights::BlackQueenside)) {
-        //std::cout << "IN IF CastlingRights: " << board.castlingRights() << "--------------------------------" << '\n';
+
+    Bitboard ownKings = kings & fromMask;
+    while(ownKings){
+        Square from = Square::fromIndexUnchecked(Bitboards::popLsb(ownKings));
+        Bitboard targets = Attacks::king(from) & typeTargets & checkTargets(from, Bitboards::Empty);
+        // the king can go to any square that is not attacked once it has left its current square
+        if(checkKing) targets &= ~board.attacks(Them, occupied ^ kings);
+        serializeMoves(from, targets, moves);
+        if(!checkers && type != GenType::Captures) generateCastlingMoves<Us>(board, from, checksOnly, moves);
     }
+    // in double check only the king can move
+    if(Bitboards::popCount(checkers) > 1) return;
 
-    for(int j = 0; j < 2; j++){
-        // check castling rights
-        //if(board.turn() == PieceColor::White && (board.castlingRights() & CastlingRights::White) != CastlingRights::None))
-        
-        // check if king exists
-        if(!board.pieceMap().count(kingIndices[i])) continue; 
-        Piece king = *board.pieceMap().at(kingIndices[i]);
-        if(king.type() != PieceType::King) continue;
+    // in check the other pieces have to capture the checker or block its line
+    Bitboard evasions = ~Bitboards::Empty;
+    if(checkers) evasions = Attacks::between(kingSquare, Square::fromIndexUnchecked(Bitboards::lsb(checkers))) | checkers;
 
-        // check if rook exist
-        if(!board.pieceMap().count(kingIndices[i]+(rankStartCount[j]*rankOffsets[j]))) continue;
-        Piece rook = *board.pieceMap().at(kingIndices[i]+(rankStartCount[j]*rankOffsets[j]));
-        if(rook.type() != PieceType::Rook) continue;
-        // check squares from king to rook for pieces
-        for(int verticalOffset = 1; verticalOffset < rankOffsets[j]; verticalOffset++){
-            // if there exists another piece in between => continue;
-            if(board.pieceMap().count(kingIndices[i]+(rankStartCount[j]*verticalOffset))) continue;
-            // if there exists no piece in between and verticalOffset is at end => add extra possible castling move;
-            if(rankStartCount[j]*verticalOffset == rankStartCount[j]*rankEndCount[j]){
-                // if king in check now => continue
-                if(board.isCheck(kingIndices[i])) continue;
-                    //if(board.turn() == PieceColor::White) Board::setCastlingRights(board, ); continue; //OK
-                // if king in check after castling => continue
-                if(board.isCheck(startSquare.rank() * 8 + startSquare.file()+(rankStartCount[j]*2))) continue; //OK
-                // if rook in capturing zone => continue
-                if(Board::pieceInCapturingZone(board, startSquare.rank() * 8 + startSquare.file()+(rankStartCount[j]))) continue; //OK
-                
-                moves.push_back(Move(startSquare, (Square)* Square::fromCoordinates(startSquare.file()+(rankStartCount[j]*2), startSquare.rank())));
-            }
+    // a pinned piece is the only piece between the king and an enemy slider, it can only move along that line
+    Bitboard pinned = Bitboards::Empty;
+    Bitboard rooks = board.pieces(PieceType::Rook) | board.pieces(PieceType::Queen);
+    Bitboard bishops = board.pieces(PieceType::Bishop) | board.pieces(PieceType::Queen);
+    if(checkKing){
+        Bitboard snipers = ((Attacks::rook(kingSquare, Bitboards::Empty) & rooks)
+                         | (Attacks::bishop(kingSquare, Bitboards::Empty) & bishops)) & enemies;
+        while(snipers){
+            Bitboard blockers = Attacks::between(kingSquare, Square::fromIndexUnchecked(Bitboards::popLsb(snipers))) & occupied;
+            if(Bitboards::popCount(blockers) == 1) pinned |= blockers & own;
         }
-    }*/
-}
+    }
 
-//OK
-void MoveGeneration::generateQueenMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves)
-{
-    // define moveOffsetDirections.
-    //std::cout << "in queen, ";
-    int moveOffsetDirections[8] = {-1,1,-8,8,-7,7,-9,9};
-    int numberOffSquaresToEdge[8] = {(int) startSquare.file(), (int) (7-startSquare.file()), (int) startSquare.rank(), (int) (7-startSquare.rank()),
-        std::min((int) (7-startSquare.file()), (int) startSquare.rank()),
-        std::min((int) startSquare.file(), (int) (7-startSquare.rank())),
-        std::min((int) startSquare.file(), (int) startSquare.rank()),
-        std::min((int) (7-startSquare.rank()), (int) (7-startSquare.file()))
-    };
+    Bitboard allowed = evasions & ~own;
+    generatePawnMoves<Us>(board, board.pieces(PieceType::Pawn, Us) & fromMask, allowed, pinned, kingSquare, checkKing, type, checks, moves);
 
-    // loop over all offset directions.
-    for(int i = 0; i < 8; i++){
-        // loop over all positions of this direction.
-        for(int j = 0; j < numberOffSquaresToEdge[i]; j++){
-            // check weater they return a valid Square by calling index using moveOffsetDirections*j.
-            Square::Optional targetSquare = Square::fromIndex(startSquare.index()+moveOffsetDirections[i]*(j+1));  
-            if(targetSquare == std::nullopt) continue;
-            // check if other piece on targetSquare. If same color piece continue, else capture it.
-            Piece::Optional otherPiece = board.piece((Square)* targetSquare);
-            if(otherPiece != std::nullopt){
-                // if enemy piece has been encountered capture and break search in this direction. else just break.
-                if(piece.color() != ((Piece)* otherPiece).color()){
-                moves.push_back(Move(startSquare,(Square)* targetSquare));
-                }
-                break;
-            }
-            moves.push_back(Move(startSquare,(Square)* targetSquare));
-        }
+    // a pinned knight can never stay on the line to its king
+    Bitboard knights = board.pieces(PieceType::Knight, Us) & fromMask & ~pinned;
+    while(knights){
+        Square from = Square::fromIndexUnchecked(Bitboards::popLsb(knights));
+        Bitboard targets = Attacks::knight(from) & allowed & typeTargets;
+        serializeMoves(from, targets & checkTargets(from, checks.squares[(int) PieceType::Knight]), moves);
     }
-}
 
-//OK
-void MoveGeneration::generateRookMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves) {
-    // define moveOffsetDirections.
-    int moveOffsetDirections[4] = {-1,1,-8,8};
-    int numberOffSquaresToEdge[4] = {(int) startSquare.file(), (int) (7-startSquare.file()), (int) startSquare.rank(), (int) (7-startSquare.rank())};
-    
-    // loop over all offset directions.
-    for(int i = 0; i < 4; i++){
-        // loop over all positions of this direction.
-        for(int j = 0; j < numberOffSquaresToEdge[i]; j++){
-            // check weater they return a valid Square by calling index using moveOffsetDirections*j.
-            Square::Optional targetSquare = Square::fromIndex(startSquare.index()+moveOffsetDirections[i]*(j+1));  
-            if(targetSquare == std::nullopt) continue;
-            // check if other piece on targetSquare. If same color piece continue, else capture it.
-            Piece::Optional otherPiece = board.piece((Square)* targetSquare);
-            if(otherPiece != std::nullopt){
-                // if enemy piece has been encountered capture and break search in this direction. else just break.
-                if(piece.color() != ((Piece)* otherPiece).color()){
-                moves.push_back(Move(startSquare,(Square)* targetSquare));
-                }
-                break;
-            }
-            moves.push_back(Move(startSquare,(Square)* targetSquare));
+    Bitboard sliders = (rooks | bishops) & own & fromMask;
+    while(sliders){
+        Square from = Square::fromIndexUnchecked(Bitboards::popLsb(sliders));
+        Bitboard targets = Bitboards::Empty;
+        Bitboard pieceChecks = Bitboards::Empty;
+        if(Bitboards::contains(rooks, from.index())){
+            targets |= Attacks::rook(from, occupied);
+            pieceChecks |= checks.squares[(int) PieceType::Rook];
+        }
+        if(Bitboards::contains(bishops, from.index())){
+            targets |= Attacks::bishop(from, occupied);
+            pieceChecks |= checks.squares[(int) PieceType::Bishop];
         }
-    }  
+        targets &= allowed & typeTargets & checkTargets(from, pieceChecks);
+        if(Bitboards::contains(pinned, from.index())) targets &= Attacks::line(kingSquare, from);
+        serializeMoves(from, targets, moves);
+    }
 }
 
-//OK
-void MoveGeneration::generateKnightMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves)
-{
-    // define moveOffsets.
-    std::tuple<int,int> moveOffsets[8] = {{-1,-2},{1,-2},{-2,-1},{-2,1},{-1,2},{1,2},{2,1},{2,-1}};
-    
-    // loop over all offset positions.
-    for(int i = 0; i < 8; i++){
-        // check weater they return a valid Square by calling index using moveOffsets.
-        Square::Optional targetSquare = Square::fromCoordinates(startSquare.file()+std::get<0>(moveOffsets[i]),
-                                                                startSquare.rank()+std::get<1>(moveOffsets[i]));
-        if(targetSquare == std::nullopt) continue;
-        // check if other piece on targetSquare. If same color piece continue, else capture it.
-        Piece::Optional otherPiece = board.piece((Square)* targetSquare);
-        if(otherPiece != std::nullopt){
-            // if enemy piece has been encountered capture and break search in this direction. else just break.
-            if(piece.color() != ((Piece)* otherPiece).color()){
-            moves.push_back(Move(startSquare,(Square)* targetSquare));
-            }
-            else continue;
-        }
-        moves.push_back(Move(startSquare,(Square)* targetSquare));
+template<int Offset>
+void MoveGeneration::serializePawnMoves(Bitboard targets, Bitboard pinned, Square kingSquare, bool promotion, MoveVec& moves) {
+    while(targets){
+        Square to = Square::fromIndexUnchecked(Bitboards::popLsb(targets));
+        Square from = Square::fromIndexUnchecked(to.index() - Offset);
+        if(Bitboards::contains(pinned, from.index()) && !Bitboards::contains(Attacks::line(kingSquare, from), to.index())) continue;
+        if(promotion) generatePromotions(from, to, moves);
+        else moves.push_back(Move(from, to));
     }
 }
 
-//OK
-void MoveGeneration::generateBishopMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves) {
-    // define moveOffsetDirections.
-    int moveOffsetDirections[4] = {-7,7,-9,9};
-    int numberOffSquaresToEdge[4] = {
-        std::min((int) (7-startSquare.file()), (int) startSquare.rank()),
-        std::min((int) startSquare.file(), (int) (7-startSquare.rank())),
-        std::min((int) startSquare.file(), (int) startSquare.rank()),
-        std::min((int) (7-startSquare.rank()), (int) (7-startSquare.file()))};
-        
-    // loop over all offset directions.
-    for(int i = 0; i < 4; i++){
-        // loop over all positions of this direction.
-        for(int j = 0; j < numberOffSquaresToEdge[i]; j++){
-            // check weater they return a valid Square by calling index using moveOffsetDirections*j.
-            Square::Optional targetSquare = Square::fromIndex(startSquare.index()+moveOffsetDirections[i]*(j+1));  
-            if(targetSquare == std::nullopt) continue;
-            // check if other piece on targetSquare. If same color piece continue, else capture it.
-            Piece::Optional otherPiece = board.piece((Square)* targetSquare);
-            if(otherPiece != std::nullopt){
-                // if enemy piece has been encountered capture and break search in this direction. else just break.
-                if(piece.color() != ((Piece)* otherPiece).color()){
-                moves.push_back(Move(startSquare,(Square)* targetSquare));
-                }
-                break;
-            }
-            moves.push_back(Move(startSquare,(Square)* targetSquare));
+template<PieceColor Us>
+void MoveGeneration::generatePawnMoves(const Board& board, Bitboard pawns, Bitboard allowed, Bitboard pinned,
+                                       Square kingSquare, bool checkKing, GenType type, const Board::CheckInfo& checks, MoveVec& moves) {
+    constexpr PieceColor Them = !Us;
+    constexpr int Up = Us == PieceColor::White ? 8 : -8;
+    // captures towards the a-file and towards the h-file
+    constexpr int UpWest = Up - 1;
+    constexpr int UpEast = Up + 1;
+    constexpr Bitboard DoubleStepRank = Bitboards::rank(Us == PieceColor::White ? 2 : 5);
+    constexpr Bitboard PromotionRank = Bitboards::rank(Us == PieceColor::White ? 7 : 0);
+
+    Bitboard empty = ~board.pieces();
+    Bitboard enemies = board.pieces(Them);
+
+    // every pawn at once: single steps, double steps from the start rank and captures to both sides
+    Bitboard singleSteps = Bitboards::shift<Up>(pawns) & empty;
+    Bitboard doubleSteps = Bitboards::shift<Up>(singleSteps & DoubleStepRank) & empty & allowed;
+    Bitboard westCaptures = Bitboards::shift<UpWest>(pawns) & enemies & allowed;
+    Bitboard eastCaptures = Bitboards::shift<UpEast>(pawns) & enemies & allowed;
+    singleSteps &= allowed;
+
+    // promotions count as captures, so quiet checks are the pushes to a checking square
+    // and the pushes of discoverers that are not on the file of the enemy king
+    if(type == GenType::QuietChecks){
+        Bitboard discoverers = pawns & checks.discoverers & ~Bitboards::file(checks.kingSquare.file());
+        Bitboard pawnChecks = checks.squares[(int) PieceType::Pawn];
+        serializePawnMoves<Up>(singleSteps & ~PromotionRank & (pawnChecks | Bitboards::shift<Up>(discoverers)), pinned, kingSquare, false, moves);
+        serializePawnMoves<2 * Up>(doubleSteps & (pawnChecks | Bitboards::shift<2 * Up>(discoverers)), pinned, kingSquare, false, moves);
+        return;
+    }
+
+    // pushes to the last rank promote and count as captures
+    if(type != GenType::Quiets){
+        serializePawnMoves<Up>(singleSteps & PromotionRank, pinned, kingSquare, true, moves);
+        serializePawnMoves<UpWest>(westCaptures & PromotionRank, pinned, kingSquare, true, moves);
+        serializePawnMoves<UpEast>(eastCaptures & PromotionRank, pinned, kingSquare, true, moves);
+        serializePawnMoves<UpWest>(westCaptures & ~PromotionRank, pinned, kingSquare, false, moves);
+        serializePawnMoves<UpEast>(eastCaptures & ~PromotionRank, pinned, kingSquare, false, moves);
+    }
+    if(type != GenType::Captures){
+        serializePawnMoves<Up>(singleSteps & ~PromotionRank, pinned, kingSquare, false, moves);
+        serializePawnMoves<2 * Up>(doubleSteps, pinned, kingSquare, false, moves);
+    }
+
+    Square::Optional enPassantSquare = board.enPassantSquare();
+    if(type == GenType::Quiets || !enPassantSquare.has_value()) return;
+    Square captured = Square::fromIndexUnchecked(enPassantSquare->index() - Up);
+    if(!Bitboards::contains(board.pieces(PieceType::Pawn, Them), captured.index())) return;
+
+    // en passant removes two pawns from the board at once, so check the king on the resulting occupancy.
+    // this also catches the capturing pawn and the captured pawn both shielding the king on their rank.
+    Bitboard capturers = Attacks::pawn(Them, *enPassantSquare) & pawns;
+    while(capturers){
+        Square from = Square::fromIndexUnchecked(Bitboards::popLsb(capturers));
+        if(checkKing){
+            Bitboard after = (board.pieces() ^ Bitboards::squareBB(from.index()) ^ Bitboards::squareBB(captured.index()))
+                           | Bitboards::squareBB(enPassantSquare->index());
+            Bitboard attackers = board.attackersTo(kingSquare, after) & enemies & ~Bitboards::squareBB(captured.index());
+            if(attackers) continue;
         }
-    }  
+        moves.push_back(Move(from, *enPassantSquare, Move::Type::EnPassant));
+    }
 }
 
+template<PieceColor Us>
+void MoveGeneration::generateCastlingMoves(const Board& board, Square kingSquare, bool checksOnly, MoveVec& moves) {
+    struct CastlingSide {
+        CastlingRights right;
+        Square rook;
+        // the rook lands on the square the king passes
+        Square kingPasses;
+        Square kingTarget;
+    };
+    constexpr bool White = Us == PieceColor::White;
+    constexpr Square KingStart = White ? Square::E1 : Square::E8;
+    constexpr CastlingSide Sides[2] = {
+        {White ? CastlingRights::WhiteKingside : CastlingRights::BlackKingside,
+         White ? Square::H1 : Square::H8, White ? Square::F1 : Square::F8, White ? Square::G1 : Square::G8},
+        {White ? CastlingRights::WhiteQueenside : CastlingRights::BlackQueenside,
+         White ? Square::A1 : Square::A8, White ? Square::D1 : Square::D8, White ? Square::C1 : Square::C8}
+    };
+
+    if(!(kingSquare == KingStart)) return;
+    Bitboard occupied = board.pieces();
+    Bitboard enemies = board.pieces(!Us);
+    // Rule 3: the king can not castle out of check
+    if(board.attackersTo(kingSquare, occupied) & enemies) return;
+
+    for(const CastlingSide& side : Sides){
+        // Rule 1: rights are lost once the king or rook has moved
+        if(!board.castlingRightsHave(side.right)) continue;
+        if(!Bitboards::contains(board.pieces(PieceType::Rook, Us), side.rook.index())) continue;
+        // Rule 2: no pieces between king and rook
+        if(Attacks::between(kingSquare, side.rook) & occupied) continue;
+        // Rule 4: the king can not pass through or land on an attacked square
+        if(board.attackersTo(side.kingPasses, occupied) & enemies) continue;
+        if(board.attackersTo(side.kingTarget, occupied) & enemies) continue;
+        Move castling(kingSquare, side.kingTarget, Move::Type::Castling);
+        if(checksOnly && !board.givesCheck(castling)) continue;
+        moves.push_back(castling);
+    }
+}
@@ -5,28 +5,46 @@
 #include "Square.hpp"
 #include "Board.hpp"
 #include "Move.hpp"
+#include "MoveList.hpp"
 #include "CastlingRights.hpp"
 
 #include <optional>
-#include <iosfwd>
-#include <vector>
-#include <memory>
-#include <map>
 
+// Move generation is templated on the side to move, so directions, promotion ranks and
+// castling squares are constants. The public functions pick the template once per call.
 class MoveGeneration {
 public:
-    using MoveVec = std::vector<Move>;
+    using MoveVec = MoveList;
+    // which legal moves to generate: captures include en passant and all promotions,
+    // quiet checks are the quiet moves (castling included) that give check
+    enum class GenType {
+        All,
+        Captures,
+        Quiets,
+        QuietChecks
+    };
+
     static void generatePseudoLegalMoves(const Board& board, MoveVec& moves, const std::optional<Square>& from = std::nullopt);
-    static void generatePieceMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generatePawnMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generateKingMoves(Board board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generateQueenMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generateRookMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generateKnightMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
-    static void generateBishopMoves(const Board& board, Square startSquare, Piece piece, MoveVec& moves);
+    // only moves that do not leave the own king in check
+    static void generateLegalMoves(const Board& board, MoveVec& moves, GenType type = GenType::All);
+    // pieces giving check to the side to move
+    static Bitboard checkers(const Board& board);
     
 private:
-
+    // pseudo-legal generation skips the check and pin masks, moves of pieces outside fromMask are skipped
+    template<PieceColor Us, bool Legal>
+    static void generate(const Board& board, MoveVec& moves, GenType type, Bitboard fromMask);
+    template<PieceColor Us>
+    static void generatePawnMoves(const Board& board, Bitboard pawns, Bitboard allowed, Bitboard pinned,
+                                  Square kingSquare, bool checkKing, GenType type, const Board::CheckInfo& checks, MoveVec& moves);
+    // add a pawn move to every square in targets, coming from offset squares behind it
+    template<int Offset>
+    static void serializePawnMoves(Bitboard targets, Bitboard pinned, Square kingSquare, bool promotion, MoveVec& moves);
+    template<PieceColor Us>
+    static void generateCastlingMoves(const Board& board, Square kingSquare, bool checksOnly, MoveVec& moves);
+    // add a move from startSquare to every square in targets
+    static void serializeMoves(Square startSquare, Bitboard targets, MoveVec& moves);
+    static void generatePromotions(Square startSquare, Square targetSquare, MoveVec& moves);
 };
 
 
@@ -0,0 +1,70 @@
+#ifndef CHESS_ENGINE_MOVELIST_HPP
+#define CHESS_ENGINE_MOVELIST_HPP
+
+#include "Move.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+
+// A list of moves stored inline, so generating moves never touches the heap.
+// No position has more than 218 legal moves, 256 leaves room for pseudo-legal ones.
+class MoveList {
+public:
+    static constexpr std::size_t Capacity = 256;
+
+    using value_type = Move;
+    using size_type = std::size_t;
+    using reference = Move&;
+    using const_reference = const Move&;
+    using iterator = Move*;
+    using const_iterator = const Move*;
+
+    MoveList() : size_(0) {}
+
+    MoveList(std::initializer_list<Move> moves) : size_(0) {
+        for(const Move& move : moves) push_back(move);
+    }
+
+    void push_back(const Move& move) {
+        assert(size_ < Capacity);
+        moves_[size_++] = move;
+    }
+
+    void pop_back() { size_--; }
+    void clear() { size_ = 0; }
+
+    // remove [first, last) and close the gap, like std::vector::erase
+    iterator erase(const_iterator first, const_iterator last) {
+        iterator target = begin() + (first - begin());
+        iterator source = begin() + (last - begin());
+        while(source != end()) *target++ = *source++;
+        size_ -= last - first;
+        return begin() + (first - begin());
+    }
+
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_type capacity() { return Capacity; }
+
+    Move& operator[](size_type index) { return moves_[index]; }
+    const Move& operator[](size_type index) const { return moves_[index]; }
+    Move& front() { return moves_[0]; }
+    const Move& front() const { return moves_[0]; }
+    Move& back() { return moves_[size_ - 1]; }
+    const Move& back() const { return moves_[size_ - 1]; }
+
+    iterator begin() { return moves_; }
+    iterator end() { return moves_ + size_; }
+    const_iterator begin() const { return moves_; }
+    const_iterator end() const { return moves_ + size_; }
+
+private:
+    // left uninitialized, only the first size_ entries are valid
+    Move moves_[Capacity];
+    size_type size_;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "MovePicker.hpp"
+#include "MoveGeneration.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+// capture scores indexed by victim and attacker type, which are listed from pawn to king by value:
+// the most valuable victim first, among captures of the same victim the least valuable attacker first
+static constexpr auto MvvLva = []{
+    std::array<std::array<int, 6>, 6> table{};
+    for(int victim = 0; victim < 6; victim++){
+        for(int attacker = 0; attacker < 6; attacker++) table[victim][attacker] = 8 * (victim + 1) - (attacker + 1);
+    }
+    return table;
+}();
+
+// a promotion counts as much as capturing the piece it promotes to
+static constexpr int PromotionBonus[6] = {0, 8 * 2, 8 * 3, 8 * 4, 8 * 5, 0};
+
+MovePicker::MovePicker(const Board& board, Move::Optional hashMove, const Killers& killers)
+    : board_(board), hashMove_(std::nullopt), killers_(killers), stage_(Stage::HashMove), mode_(Mode::All), current_(0), killer_(0)
+{
+    // a hash move from another position may not be legal here, only keep it when it is
+    if(hashMove.has_value() && board.isPseudoLegal(*hashMove) && board.isLegal(*hashMove)) hashMove_ = hashMove;
+}
+
+MovePicker::MovePicker(const Board& board, Mode mode)
+    : board_(board), hashMove_(std::nullopt), killers_(), stage_(Stage::GenerateCaptures), mode_(mode), current_(0), killer_(0)
+{
+}
+
+bool MovePicker::isQuiet(const Board& board, const Move& move) {
+    if(board.piece(move.to()).has_value() || move.promotion().has_value()) return false;
+    // en passant also when the move was not flagged as such
+    Piece::Optional mover = board.piece(move.from());
+    bool enPassant = mover.has_value() && mover->type() == PieceType::Pawn && move.to() == board.enPassantSquare();
+    return !enPassant && move.type() != Move::Type::EnPassant;
+}
+
+bool MovePicker::isHashMove(const Move& move) const {
+    return hashMove_.has_value() && *hashMove_ == move;
+}
+
+bool MovePicker::isKiller(const Move& move) const {
+    for(const Move::Optional& killer : killers_){
+        if(killer.has_value() && *killer == move) return true;
+    }
+    return false;
+}
+
+int MovePicker::captureScore(const Move& move) const {
+    // table lookups only, the exchange itself is judged by isGoodCapture once the move comes up
+    const Position& position = board_.position();
+    PieceType mover = position.pieceOn(move.from()).type();
+    int score = 0;
+    if(!position.isEmpty(move.to())) score = MvvLva[(int) position.pieceOn(move.to()).type()][(int) mover];
+    else if(mover == PieceType::Pawn && move.to() == position.enPassantSquare) score = MvvLva[(int) PieceType::Pawn][(int) PieceType::Pawn];
+    if(move.promotion().has_value()) score += PromotionBonus[(int) *move.promotion()];
+    return score;
+}
+
+bool MovePicker::isGoodCapture(const Move& move) const {
+    // the recaptures on the target square, with defenders behind the first ones, may not win back more
+    return board_.seeGe(move, 0);
+}
+
+void MovePicker::scoreQuiets() {
+    Board::CheckInfo checks = board_.checkInfo();
+
+    // quiet moves that give check go first, they are the ones most likely to cut off
+    for(std::size_t i = 0; i < quiets_.size(); i++) quietScores_[i] = board_.givesCheck(quiets_[i], checks) ? 1 : 0;
+}
+
+Move MovePicker::selectBest(MoveVec& moves, int* scores) {
+    // selection sort one move at a time, the rest stays unsorted if a cutoff happens
+    std::size_t best = current_;
+    for(std::size_t i = current_ + 1; i < moves.size(); i++){
+        if(scores[i] > scores[best]) best = i;
+    }
+    std::swap(moves[current_], moves[best]);
+    std::swap(scores[current_], scores[best]);
+    return moves[current_++];
+}
+
+Move::Optional MovePicker::next() {
+    switch(stage_){
+        case Stage::HashMove:
+            stage_ = Stage::GenerateCaptures;
+            if(hashMove_.has_value()) return hashMove_;
+            [[fallthrough]];
+
+        case Stage::GenerateCaptures: {
+            MoveGeneration::generateLegalMoves(board_, captures_, MoveGeneration::GenType::Captures);
+            if(hashMove_.has_value()) captures_.erase(std::remove(captures_.begin(), captures_.end(), *hashMove_), captures_.end());
+            for(std::size_t i = 0; i < captures_.size(); i++) captureScores_[i] = captureScore(captures_[i]);
+            stage_ = Stage::GoodCaptures;
+            [[fallthrough]];
+        }
+
+        case Stage::GoodCaptures:
+            while(current_ < captures_.size()){
+                Move move = selectBest(captures_, captureScores_);
+                if(isGoodCapture(move)) return move;
+                if(mode_ == Mode::All) badCaptures_.push_back(move);
+            }
+            if(mode_ == Mode::GoodCaptures){
+                stage_ = Stage::Done;
+                break;
+            }
+            stage_ = Stage::Killers;
+            [[fallthrough]];
+
+        case Stage::Killers:
+            // killers are validated on their own, so a killer cutoff never generates the quiet moves
+            while(killer_ < killers_.size()){
+                Move::Optional killer = killers_[killer_++];
+                if(!killer.has_value() || isHashMove(*killer)) continue;
+                if(killer_ == 2 && killers_[0].has_value() && *killers_[0] == *killer) continue;
+                if(board_.isPseudoLegal(*killer) && isQuiet(board_, *killer) && board_.isLegal(*killer)) return killer;
+            }
+            stage_ = Stage::GenerateQuiets;
+            [[fallthrough]];
+
+        case Stage::GenerateQuiets:
+            MoveGeneration::generateLegalMoves(board_, quiets_, MoveGeneration::GenType::Quiets);
+            scoreQuiets();
+            current_ = 0;
+            stage_ = Stage::Quiets;
+            [[fallthrough]];
+
+        case Stage::Quiets:
+            while(current_ < quiets_.size()){
+                Move move = selectBest(quiets_, quietScores_);
+                if(!isHashMove(move) && !isKiller(move)) return move;
+            }
+            current_ = 0;
+            stage_ = Stage::BadCaptures;
+            [[fallthrough]];
+
+        case Stage::BadCaptures:
+            if(current_ < badCaptures_.size()) return badCaptures_[current_++];
+            stage_ = Stage::Done;
+            [[fallthrough]];
+
+        case Stage::Done:
+            break;
+    }
+    return std::nullopt;
+}
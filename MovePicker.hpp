@@ -0,0 +1,72 @@
+#ifndef CHESS_ENGINE_MOVEPICKER_HPP
+#define CHESS_ENGINE_MOVEPICKER_HPP
+
+#include "Board.hpp"
+#include "Move.hpp"
+#include "MoveList.hpp"
+
+#include <array>
+#include <cstddef>
+
+// Hands out the legal moves of a position one at a time, best candidates first.
+// Moves are generated in stages and a stage is only generated once the previous
+// one is used up, so a node that is cut off early never generates its quiet moves.
+class MovePicker {
+public:
+    using MoveVec = MoveList;
+    // quiet moves that caused a beta cutoff at the same ply elsewhere in the tree
+    using Killers = std::array<Move::Optional, 2>;
+
+    // which moves the picker hands out
+    enum class Mode {
+        All,
+        GoodCaptures // only captures and promotions that do not lose material, for the quiescence search
+    };
+
+    MovePicker(const Board& board, Move::Optional hashMove = std::nullopt, const Killers& killers = Killers());
+    MovePicker(const Board& board, Mode mode);
+
+    // the next move to search, std::nullopt once every legal move has been returned
+    Move::Optional next();
+
+    // moves that do not capture or promote
+    static bool isQuiet(const Board& board, const Move& move);
+
+private:
+    enum class Stage {
+        HashMove,
+        GenerateCaptures,
+        GoodCaptures,
+        Killers,
+        GenerateQuiets,
+        Quiets,
+        BadCaptures,
+        Done
+    };
+
+    bool isHashMove(const Move& move) const;
+    bool isKiller(const Move& move) const;
+    int captureScore(const Move& move) const;
+    // whether capturing with move can not lose material
+    bool isGoodCapture(const Move& move) const;
+    void scoreQuiets();
+    // the best scored of the moves from current_ on, which is moved to current_ and passed
+    Move selectBest(MoveVec& moves, int* scores);
+
+    const Board& board_;
+    Move::Optional hashMove_;
+    Killers killers_;
+    Stage stage_;
+    Mode mode_;
+
+    // captureScores_[i] belongs to captures_[i], quietScores_[i] to quiets_[i]
+    MoveVec captures_;
+    int captureScores_[MoveList::Capacity];
+    MoveVec badCaptures_;
+    MoveVec quiets_;
+    int quietScores_[MoveList::Capacity];
+    std::size_t current_;
+    std::size_t killer_;
+};
+
+#endif
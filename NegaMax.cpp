@@ -1,5 +1,8 @@
 #include "NegaMax.hpp"
 #include "Move.hpp"
+#include "MoveGeneration.hpp"
+#include "MovePicker.hpp"
+#include "TranspositionTable.hpp"
 
 #include <ostream>
 #include <cassert>
@@ -9,84 +12,320 @@
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <cstdint>
+#include <limits>
 #include <sys/time.h>
-#include <random>
 
-enum class FlagType {
-    LOWERBOUND,
-    UPPERBOUND,
-    EXACT
+static NegaMax::MoveMaking moveMaking_ = NegaMax::MoveMaking::MakeUnmake;
+
+// distance from the root of the search, kept up to date by playMove and takeBackMove.
+// every search thread has its own, only the transposition table is shared
+static constexpr int MaxPly = 128;
+static thread_local int searchPly_ = 0;
+// per ply the last two quiet moves that caused a beta cutoff
+static thread_local MovePicker::Killers killers_[MaxPly];
+
+static unsigned threads_ = 1;
+static NegaMax::ParallelSearch parallelSearch_ = NegaMax::ParallelSearch::LazySmp;
+// set once the main thread is done, the helper threads stop as if their time was up
+static std::atomic<bool> stop_(false);
+
+// positions visited by this thread in the main and in the quiescence search,
+// added to nodes_ and qnodes_ when its part of the search is done
+static thread_local std::uint64_t threadNodes_ = 0;
+static thread_local std::uint64_t threadQNodes_ = 0;
+static std::atomic<std::uint64_t> nodes_(0);
+static std::atomic<std::uint64_t> qnodes_(0);
+
+// Young Brothers Wait: once the eldest brother of a node is searched its siblings are split off as
+// tasks on the deque of the thread searching the node. Idle threads steal them from the other end.
+struct SplitPoint {
+    SplitPoint(const Board& board, int depth, int alpha, int beta, time_t endTime, SplitPoint* parent)
+        : board(board), depth(depth), beta(beta), ply(searchPly_), endTime(endTime), parent(parent),
+          alpha(alpha), pending(0), cutoff(false), mate(false) {}
+
+    const Board board;
+    const int depth;
+    const int beta;
+    const int ply;
+    const time_t endTime;
+    // the split point this node was searched under, a cutoff there makes this one pointless too
+    SplitPoint* const parent;
+
+    std::atomic<int> alpha;
+    std::atomic<int> pending;
+    std::atomic<bool> cutoff;
+    // a sibling saw a checkmate, only the owner touches its principal variation
+    std::atomic<bool> mate;
+    // guards alpha and bestMove together
+    std::mutex mutex;
+    Move::Optional bestMove;
+    // the moves handed out as tasks
+    MoveList siblings;
 };
 
-struct BoardStruct {
-    int depth;
-    int eval;
-    int alpha;
-    int beta;
-    std::optional<Move> bestMove;
-    FlagType flag; 
-    BoardStruct(int depth, int eval, int alpha, int beta, std::optional<Move> bestMove, FlagType flag) 
-    : depth(depth), eval(eval), alpha(alpha), beta(beta), bestMove(bestMove), flag(flag) {}
+struct SplitTask {
+    SplitPoint* splitPoint;
+    Move move;
 };
 
-int NegaMax::negaMax(Board board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, std::optional<Square> from){
-    std::cout << "---------------"; 
-    std::cout << "\n in Negamax \n"; 
-    std::cout << "---------------\n"; 
-    /*
-    int alphaOrig = alpha;
-    // transposition table lookup
-    unsigned long long int zobristHash = NegaMax::computeZobristHash(zobristTable, board);
-    if(boardStructMap.count(zobristHash)){
-        BoardStruct bs = *boardStructMap.at(zobristHash);
-        if(bs.flag == FlagType::EXACT) return bs.eval;
-        else if(bs.flag == FlagType::LOWERBOUND)
-            alpha = std::max(alpha, bs.eval);
-        else if(bs.flag == FlagType::UPPERBOUND)
-            beta = std::min(beta, bs.eval);
-        if(alpha >= beta) return bs.eval;
-    }*/
-    
-    // generate pseudo legal moves for own color
-    Board::MoveVec generatedMovesBoardColor = Board::MoveVec();
-    NegaMax::generatePseudoLegalMoves(board, generatedMovesBoardColor, false, from);
-    
-    // generate pseudo legal moves for opposing color
-    Board::MoveVec generatedMovesOtherColor = Board::MoveVec();
-    NegaMax::generatePseudoLegalMoves(board, generatedMovesOtherColor, true, from);
+// the owner pushes and pops at the back, thieves take the oldest and largest tasks at the front
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<SplitTask> tasks;
+};
+
+// nodes closer to the leaves are not worth the copy of the board
+static constexpr int MinSplitDepth = 3;
+static std::vector<std::unique_ptr<WorkQueue>> queues_;
+static std::atomic<bool> splitting_(false);
+static thread_local unsigned threadId_ = 0;
+// the split point of the task this thread is searching
+static thread_local SplitPoint* splitPoint_ = nullptr;
+
+static bool cutOff(const SplitPoint* splitPoint) {
+    for(; splitPoint != nullptr; splitPoint = splitPoint->parent){
+        if(splitPoint->cutoff.load(std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+// out of time, done, or refuted higher up by a sibling on another thread
+static bool stopped(time_t endTime) {
+    return stop_.load(std::memory_order_relaxed) || time(nullptr) > endTime || cutOff(splitPoint_);
+}
+
+static void storeKiller(const Move& move) {
+    if(searchPly_ >= MaxPly) return;
+    MovePicker::Killers& killers = killers_[searchPly_];
+    if(killers[0].has_value() && *killers[0] == move) return;
+    killers[1] = killers[0];
+    killers[0] = move;
+}
+
+static MovePicker::Killers killersAtPly() {
+    return searchPly_ < MaxPly ? killers_[searchPly_] : MovePicker::Killers();
+}
+
+// results of earlier searches of a position, kept between moves of a game
+static TranspositionTable table_(NegaMax::DefaultHashMegabytes);
+
+void NegaMax::setHashSize(std::size_t megabytes) {
+    table_.resize(megabytes);
+}
+
+void NegaMax::clearHash() {
+    table_.clear();
+}
+
+void NegaMax::setThreads(unsigned threads) {
+    threads_ = std::max(1u, threads);
+}
+
+unsigned NegaMax::threads() {
+    return threads_;
+}
+
+void NegaMax::setParallelSearch(ParallelSearch parallelSearch) {
+    parallelSearch_ = parallelSearch;
+}
+
+NegaMax::ParallelSearch NegaMax::parallelSearch() {
+    return parallelSearch_;
+}
 
-    // if no move generated => return lowest possible value
-    if(board.isCheckMate(generatedMovesBoardColor, generatedMovesOtherColor)){ /*std::cout << "IS CHECKMATE--------\n";*/
+std::uint64_t NegaMax::nodes() {
+    return nodes_;
+}
+
+std::uint64_t NegaMax::qnodes() {
+    return qnodes_;
+}
+
+void NegaMax::setMoveMaking(MoveMaking moveMaking) {
+    moveMaking_ = moveMaking;
+}
+
+NegaMax::MoveMaking NegaMax::moveMaking() {
+    return moveMaking_;
+}
+
+// play move with the selected move making, saved receives what takeBackMove needs to undo it
+static void playMove(Board& board, const Move& move, Position& saved) {
+    if(moveMaking_ == NegaMax::MoveMaking::CopyMake){
+        saved = board.position();
+        board.setPosition(doMove(saved, move));
+    }
+    else board.makeMove(move);
+    // the child probes the table first thing, start loading its entry now
+    table_.prefetch(board.key());
+    searchPly_++;
+}
+
+static void takeBackMove(Board& board, const Move& move, const Position& saved) {
+    if(moveMaking_ == NegaMax::MoveMaking::CopyMake) board.setPosition(saved);
+    else board.reverseMove(move);
+    searchPly_--;
+}
+
+// score of a position without legal moves
+static int mateOrStalemate(const Board& board, PrincipalVariation& pv) {
+    if(MoveGeneration::checkers(board)){
         pv.setIsMate(true);
-        return - std::numeric_limits<int>::max();
+        return - (NegaMax::Mate - searchPly_);
+    }
+    return 0;
+}
+
+// scores this close to Mate are mates within the search
+static bool isMateScore(int score) {
+    return score >= NegaMax::Mate - MaxPly || score <= - (NegaMax::Mate - MaxPly);
+}
+
+// the table keeps mate scores as the distance from the stored node, so they hold at any ply it is probed from.
+// the window bounds of ±Mate are clamped, they do not come from a mate
+static int toTableScore(int score) {
+    if(!isMateScore(score)) return score;
+    return score > 0 ? std::min(score + searchPly_, NegaMax::Mate) : std::max(score - searchPly_, - NegaMax::Mate);
+}
+
+static int fromTableScore(int score) {
+    if(!isMateScore(score)) return score;
+    return score > 0 ? score - searchPly_ : score + searchPly_;
+}
+
+// the next sibling of splitPoint on the deque of this thread, the tasks of other nodes wait for their turn
+static std::optional<SplitTask> popTask(const SplitPoint& splitPoint) {
+    WorkQueue& queue = *queues_[threadId_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if(queue.tasks.empty() || queue.tasks.back().splitPoint != &splitPoint) return std::nullopt;
+    SplitTask task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return task;
+}
+
+static bool isBelow(const SplitPoint* splitPoint, const SplitPoint* ancestor) {
+    for(; splitPoint != nullptr; splitPoint = splitPoint->parent){
+        if(splitPoint == ancestor) return true;
+    }
+    return false;
+}
+
+// the oldest task on the deque of another thread. with under, only a task of a node below that
+// split point, which is work the owner of under waits for anyway
+static std::optional<SplitTask> stealTask(const SplitPoint* under = nullptr) {
+    for(std::size_t i = 1; i < queues_.size(); i++){
+        WorkQueue& queue = *queues_[(threadId_ + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(queue.tasks.empty()) continue;
+        if(under != nullptr && !isBelow(queue.tasks.front().splitPoint, under)) continue;
+        SplitTask task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return task;
+    }
+    return std::nullopt;
+}
+
+// search one sibling of a split point on a copy of its board, with the best alpha found so far
+static void searchTask(const SplitTask& task) {
+    SplitPoint& splitPoint = *task.splitPoint;
+    if(!cutOff(&splitPoint)){
+        SplitPoint* previousSplitPoint = splitPoint_;
+        int previousPly = searchPly_;
+        splitPoint_ = &splitPoint;
+        searchPly_ = splitPoint.ply;
+
+        Board board = splitPoint.board;
+        std::vector<Move> pvMoves;
+        PrincipalVariation pv(pvMoves, board);
+        Position saved;
+        playMove(board, task.move, saved);
+        int eval = - NegaMax::negamaxSearch(board, splitPoint.depth - 1, - splitPoint.beta, - splitPoint.alpha.load(), splitPoint.endTime, pv);
+        // a search cut short says nothing about the move
+        bool complete = !stopped(splitPoint.endTime);
+        splitPoint_ = previousSplitPoint;
+        searchPly_ = previousPly;
+
+        if(pv.isMate()) splitPoint.mate = true;
+        if(complete){
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            if(eval > splitPoint.alpha){
+                splitPoint.alpha = eval;
+                splitPoint.bestMove = task.move;
+                if(eval >= splitPoint.beta) splitPoint.cutoff = true;
+            }
+        }
+    }
+    splitPoint.pending--;
+}
+
+// search the moves left in picker together with idle threads, true on a beta cutoff.
+// while it waits the owner only takes work below this node, so it is never stuck in an unrelated subtree
+static bool splitSearch(Board& board, MovePicker& picker, int depth, int& alpha, int beta, time_t endTime,
+                        PrincipalVariation& pv, Move::Optional& bestMove) {
+    SplitPoint splitPoint(board, depth, alpha, beta, endTime, splitPoint_);
+    while(Move::Optional next = picker.next()) splitPoint.siblings.push_back(*next);
+    if(splitPoint.siblings.empty()) return false;
+
+    splitPoint.pending = (int) splitPoint.siblings.size();
+    {
+        // reversed, so the owner pops the best sibling first and thieves take the last ones
+        WorkQueue& queue = *queues_[threadId_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for(std::size_t i = splitPoint.siblings.size(); i > 0; i--){
+            queue.tasks.push_back({&splitPoint, splitPoint.siblings[i - 1]});
+        }
+    }
+    // helpful master: once its own siblings are taken the owner helps the threads that took them
+    while(splitPoint.pending > 0){
+        if(std::optional<SplitTask> task = popTask(splitPoint)) searchTask(*task);
+        else if(std::optional<SplitTask> task = stealTask(&splitPoint)) searchTask(*task);
+        else std::this_thread::yield();
     }
-    if(board.isStaleMate(generatedMovesOtherColor)){ //TODO: is true when starting from startpos
-        std::cout << "IS STALEMATE--------\n";
-        return 0; 
-    }; 
 
-    // order generated legal moves from best to worst to speed up alpha beta pruning
-    board.orderMoves(generatedMovesBoardColor); // OK but slower
+    if(splitPoint.mate) pv.setIsMate(true);
+    if(splitPoint.alpha > alpha){
+        alpha = splitPoint.alpha;
+        bestMove = splitPoint.bestMove;
+    }
+    return splitPoint.cutoff;
+}
+
+int NegaMax::negaMax(Board& board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, std::optional<Square> from){
+    std::cout << "---------------"; 
+    std::cout << "\n in Negamax \n"; 
+    std::cout << "---------------\n"; 
     
+    // the best move of the previous iteration is searched first, the table's best move without one
+    Move::Optional previousBest = std::nullopt;
+    if(pv.length() > 0) previousBest = *pv.begin();
+    else if(std::optional<TranspositionTable::Result> entry = table_.probe(board.key())) previousBest = entry->move;
+    MovePicker picker(board, previousBest, killersAtPly());
+
     // perform negamax algorithm
     int value = - std::numeric_limits<int>::max();
     int bestValue = - std::numeric_limits<int>::max();
-    if(generatedMovesBoardColor.size() == 0) return 0; 
-    Move bestMove = generatedMovesBoardColor.at(0);
-    //printBoardWithPossibleMoves(board, generatedMovesBoardColor);
-    //for(Move move: generatedMovesBoardColor) std::cout << "move: " << move;
-    for(Move move: generatedMovesBoardColor){
-        if(time(nullptr) > endTime) break;
+    Move::Optional bestMove = std::nullopt;
+    while(Move::Optional next = picker.next()){
+        Move move = *next;
+        if(from != std::nullopt && !(move.from() == *from)) continue;
+        if(!bestMove.has_value()) bestMove = move;
+        if(stopped(endTime)) break;
         //std::cout << "\n move: " << move << '\n';
         // make move
-        board.makeMove(move);
+        Position saved;
+        playMove(board, move, saved);
         // eval move
         int eval = - negamaxSearch(board, depth-1, - beta, -alpha, endTime, pv);
         //std::cout << "|-score-|: " << eval;
         // take best eval
         value = std::max(value, eval);
         // reverse move
-        board.reverseMove(move);
+        takeBackMove(board, move, saved);
         // perform alpha beta pruning
         alpha = std::max(alpha, value);  
         if(alpha > beta) break;
@@ -97,105 +336,183 @@ int NegaMax::negaMax(Board board, int depth, int alpha, int beta, time_t endTime
             bestMove = move;
         }
     }
-    /*
-    // add board to boardStructMap
-    BoardStruct bs = BoardStruct(depth, bestValue, alpha, beta, pv.bestMove, FlagType::EXACT);    
-    if(bestValue <= alphaOrig) bs = BoardStruct(depth, bestValue, alpha, beta, pv.bestMove, FlagType::UPPERBOUND);
-    else if (bestValue >= beta) bs = BoardStruct(depth, bestValue, alpha, beta, pv.bestMove, FlagType::LOWERBOUND);
-    boardStructMap[zobristHash] = std::make_shared<BoardStruct>(bs);*/
+
+    // no legal moves => checkmate when in check, stalemate otherwise
+    if(!bestMove.has_value()) return mateOrStalemate(board, pv);
+    // a search cut short by the clock did not see every move
+    if(from == std::nullopt && !stopped(endTime))
+        table_.store(board.key(), bestMove, toTableScore(bestValue), depth, TranspositionTable::Bound::Exact);
     
-    std::cout << "\n printing best move: " << bestMove << '\n'; 
-    board.makeMove(bestMove);
+    std::cout << "\n printing best move: " << *bestMove << '\n'; 
+    board.makeMove(*bestMove);
     std::cout << "board: \n" << board;
-    board.reverseMove(bestMove);
+    board.reverseMove(*bestMove);
     std::cout << "after reverse move";
     // add best move to pv
     //pv.insert(v.begin(), 6);
-    pv.enQueueMove(bestMove);
+    pv.enQueueMove(*bestMove);
     return bestValue;
 }
 
-int NegaMax::negamaxSearch(Board board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional< Square > from)
+// what capturing with move wins at first, before any recapture
+static int capturedValue(const Board& board, const Move& move) {
+    Piece::Optional captured = board.piece(move.to());
+    if(captured.has_value()) return board.pieceValue(captured->type());
+    return MovePicker::isQuiet(board, move) ? 0 : board.pieceValue(PieceType::Pawn);
+}
+
+// a capture that can not bring the score this close to alpha is not searched
+static constexpr int DeltaMargin = 20;
+
+int NegaMax::quiescence(Board& board, int alpha, int beta, time_t endTime, PrincipalVariation& pv)
 {
-    /*
-    int alphaOrig = alpha;
-    // transposition table lookup
-    unsigned long long int zobristHash = NegaMax::computeZobristHash(zobristTable, board);
-    if(boardStructMap.count(zobristHash)){
-        BoardStruct bs = *boardStructMap.at(zobristHash);
-        if(bs.flag == FlagType::EXACT) return bs.eval;
-        else if(bs.flag == FlagType::LOWERBOUND)
-            alpha = std::max(alpha, bs.eval);
-        else if(bs.flag == FlagType::UPPERBOUND)
-            beta = std::min(beta, bs.eval);
-        if(alpha >= beta) return bs.eval;
-    }*/
-    
-    // generate pseudo legal moves for own color
-    Board::MoveVec generatedMovesBoardColor = Board::MoveVec();
-    NegaMax::generatePseudoLegalMoves(board, generatedMovesBoardColor, false, from);
-    
-    // reject the previous move if the other color was in check by giving the board the highest scores
-    //std::cout << "previous board in check: " << board.isCheck(generatedMovesBoardColor, std::nullopt, !board.turn());
-    if(board.isCheck(generatedMovesBoardColor, std::nullopt, !board.turn())){
-        return std::numeric_limits<int>::max();
+    threadQNodes_++;
+    if(stopped(endTime)) return alpha;
+    if(searchPly_ >= MaxPly) return std::clamp(board.evaluate(), alpha, beta);
+
+    // out of check the side to move may stand pat instead of capturing, in check every evasion is searched
+    bool inCheck = MoveGeneration::checkers(board) != 0;
+    int standPat = - std::numeric_limits<int>::max();
+    if(!inCheck){
+        standPat = board.evaluate();
+        if(standPat >= beta) return beta;
+        alpha = std::max(alpha, standPat);
     }
-    
-    // generate pseudo legal moves for opposing color
-    Board::MoveVec generatedMovesOtherColor = Board::MoveVec();
-    NegaMax::generatePseudoLegalMoves(board, generatedMovesOtherColor, true, from);
-    
-    // if no move generated => return lowest possible value
-    if(board.isCheckMate(generatedMovesBoardColor, generatedMovesOtherColor)){ std::cout << "IS CHECKMATE--------\n";
-        pv.setIsMate(true);
-        return - std::numeric_limits<int>::max();
+
+    // captures that lose material are not searched at all
+    MovePicker picker = inCheck ? MovePicker(board) : MovePicker(board, MovePicker::Mode::GoodCaptures);
+    bool anyMove = false;
+    while(Move::Optional next = picker.next()){
+        Move move = *next;
+        anyMove = true;
+        if(!inCheck && !move.promotion().has_value() && standPat + capturedValue(board, move) + DeltaMargin <= alpha) continue;
+        Position saved;
+        playMove(board, move, saved);
+        int eval = - quiescence(board, - beta, - alpha, endTime, pv);
+        takeBackMove(board, move, saved);
+        if(stopped(endTime)) return alpha;
+        if(eval >= beta) return beta;
+        alpha = std::max(alpha, eval);
     }
-    if(board.isStaleMate(generatedMovesOtherColor)){ //TODO: is true when starting from startp
-        std::cout << "IS STALEMATE--------\n";
-        return 0;
-    }; 
-    
+    // in check without an evasion
+    if(inCheck && !anyMove) return mateOrStalemate(board, pv);
+    return alpha;
+}
+
+int NegaMax::negamaxSearch(Board& board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional< Square > from)
+{
     //std::cout << "in negamaxSearch \n";
-    if(depth == 0){ // || board.hasNoChildren())
-        //std::cout << "Eval Board: \n" << board;
-        //std::cout << " Board Score: " << board.evaluate() << '\n';
-        //std::cout << "-----------------\n";
-        return board.evaluate(generatedMovesBoardColor, generatedMovesOtherColor);
+    // captures are played out until the position is quiet enough to trust its evaluation
+    if(depth == 0) return quiescence(board, alpha, beta, endTime, pv);
+    threadNodes_++;
+
+    // an earlier visit that searched deep enough can settle the node, otherwise its best move goes first
+    int alphaOrig = alpha;
+    Move::Optional hashMove = std::nullopt;
+    if(from == std::nullopt){
+        if(std::optional<TranspositionTable::Result> entry = table_.probe(board.key())){
+            hashMove = entry->move;
+            int score = fromTableScore(entry->score);
+            if(entry->depth >= depth){
+                if(entry->bound == TranspositionTable::Bound::Exact) return std::clamp(score, alpha, beta);
+                if(entry->bound == TranspositionTable::Bound::Lower && score >= beta) return beta;
+                if(entry->bound == TranspositionTable::Bound::Upper && score <= alpha) return alpha;
+            }
+        }
     }
 
-    // order generated legal moves from best to worst to speed up alpha beta pruning
-    board.orderMoves(generatedMovesBoardColor); // OK but slower
-    
-    //for(Move move: generatedLegalMoves) std::cout << "move: " << move << ",";
-    // perform negamax algorithm
-    //int value = - std::numeric_limits<int>::max();
-    if(generatedMovesBoardColor.size() == 0) return 0;
-    Move bestMove = generatedMovesBoardColor.at(0);
+    // moves come out of the picker best first and are only generated when needed
+    MovePicker picker(board, hashMove, killersAtPly());
+    Move::Optional bestMove = std::nullopt;
+    bool anyMove = false;
     int eval = - std::numeric_limits<int>::max();
-    for(Move move: generatedMovesBoardColor){
-        if(time(nullptr) > endTime) return alpha;
+    while(Move::Optional next = picker.next()){
+        Move move = *next;
+        if(from != std::nullopt && !(move.from() == *from)) continue;
+        anyMove = true;
+        if(stopped(endTime)) return alpha;
+        bool quiet = MovePicker::isQuiet(board, move);
         //std::cout << "\n move: " << move << '\n';
         // make move
-        board.makeMove(move);
+        Position saved;
+        playMove(board, move, saved);
         // eval move
         eval = - negamaxSearch(board, depth-1, - beta, -alpha, endTime, pv);
         // reverse move
-        board.reverseMove(move);
-        // perform alpha beta pruning
-        if(eval >= beta) return beta;
-        alpha = std::max(alpha, eval);  
+        takeBackMove(board, move, saved);
+        // perform alpha beta pruning, quiet moves that cut off are tried early at this ply next time
+        if(eval >= beta){
+            if(quiet) storeKiller(move);
+            if(from == std::nullopt && !stopped(endTime))
+                table_.store(board.key(), move, toTableScore(beta), depth, TranspositionTable::Bound::Lower);
+            return beta;
+        }
+        if(eval > alpha){
+            alpha = eval;
+            bestMove = move;
+        }
+        // with the eldest brother searched the others may go to idle threads, which takes every move left
+        if(splitting_.load(std::memory_order_relaxed) && depth >= MinSplitDepth && from == std::nullopt){
+            if(splitSearch(board, picker, depth, alpha, beta, endTime, pv, bestMove)){
+                if(MovePicker::isQuiet(board, *bestMove)) storeKiller(*bestMove);
+                if(!stopped(endTime)) table_.store(board.key(), bestMove, toTableScore(beta), depth, TranspositionTable::Bound::Lower);
+                return beta;
+            }
+            break;
+        }
+    }
+    // no legal moves => checkmate when in check, stalemate otherwise
+    if(!anyMove) return mateOrStalemate(board, pv);
+    // without a move above alpha the score is only an upper bound
+    if(from == std::nullopt && !stopped(endTime)){
+        TranspositionTable::Bound bound = alpha > alphaOrig ? TranspositionTable::Bound::Exact : TranspositionTable::Bound::Upper;
+        table_.store(board.key(), bestMove, toTableScore(alpha), depth, bound);
     }
-    /*
-    // add board to boardStructMap
-    BoardStruct bs = BoardStruct(depth, eval, alpha, beta, pv.bestMove, FlagType::EXACT);    
-    if(eval <= alphaOrig) bs = BoardStruct(depth, eval, alpha, beta, pv.bestMove, FlagType::UPPERBOUND);
-    else if (eval >= beta) bs = BoardStruct(depth, eval, alpha, beta, pv.bestMove, FlagType::LOWERBOUND);
-    boardStructMap[zobristHash] = std::make_shared<BoardStruct>(bs);
-    */
     return alpha;
 }
 
-int NegaMax::iterativeDeepening(Board board, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional<Square> from)
+// Lazy SMP helper: the same iterative deepening without reporting anything. It starts at another depth and
+// searches the root moves in an order of its own, so it fills the shared table with other subtrees than the main thread
+static void helperSearch(Board board, unsigned id, int maxDepth, time_t endTime) {
+    std::fill(std::begin(killers_), std::end(killers_), MovePicker::Killers());
+    searchPly_ = 0;
+    Board::MoveVec moves;
+    board.legalMoves(moves);
+    if(moves.empty()) return;
+    std::rotate(moves.begin(), moves.begin() + id % moves.size(), moves.end());
+
+    std::vector<Move> pvMoves;
+    PrincipalVariation pv(pvMoves, board);
+    for(int depth = 1 + id % 2; depth <= maxDepth && !stopped(endTime); depth++){
+        int alpha = - std::numeric_limits<int>::max();
+        Move::Optional bestMove = std::nullopt;
+        for(const Move& move : moves){
+            Position saved;
+            playMove(board, move, saved);
+            int eval = - NegaMax::negamaxSearch(board, depth - 1, - std::numeric_limits<int>::max(), - alpha, endTime, pv);
+            takeBackMove(board, move, saved);
+            if(stopped(endTime)) return;
+            if(!bestMove.has_value() || eval > alpha){
+                alpha = eval;
+                bestMove = move;
+            }
+        }
+        table_.store(board.key(), bestMove, toTableScore(alpha), depth, TranspositionTable::Bound::Exact);
+    }
+}
+
+// an idle thread of the Young Brothers Wait search, busy with stolen siblings until the main thread is done
+static void splitWorker(unsigned id) {
+    std::fill(std::begin(killers_), std::end(killers_), MovePicker::Killers());
+    threadId_ = id;
+    while(!stop_.load(std::memory_order_relaxed)){
+        if(std::optional<SplitTask> task = stealTask()) searchTask(*task);
+        // nothing to take on any deque
+        else std::this_thread::yield();
+    }
+}
+
+int NegaMax::iterativeDeepening(Board board, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional<Square> from, int maxDepth)
 {   
     (void) from;
     int value = 0;
@@ -205,18 +522,49 @@ int NegaMax::iterativeDeepening(Board board, int alpha, int beta, time_t endTime
     (void) pti;
     //if(board.turn() == PieceColor::White) pti = timeInfo.white;
     //else pti = timeInfo.black;
-    /*unsigned long long int zobristTable[64][12];
-    NegaMax::initZobristTable(zobristTable);
-    std::map<unsigned long long int, std::shared_ptr<BoardStruct>> boardStructMap = std::map<unsigned long long int, std::shared_ptr<BoardStruct>>();*/
     
+    // killers from an earlier search belong to other positions, table entries may still help
+    std::fill(std::begin(killers_), std::end(killers_), MovePicker::Killers());
+    table_.newSearch();
+    searchPly_ = 0;
+
+    // the helpers share the table with this thread, which alone reports its result.
+    // Lazy SMP helpers search the whole tree themselves, split workers only the siblings they steal
+    stop_ = false;
+    nodes_ = 0;
+    qnodes_ = 0;
+    threadNodes_ = 0;
+    threadQNodes_ = 0;
+    bool split = parallelSearch_ == ParallelSearch::YoungBrothersWait && threads_ > 1;
+    queues_.clear();
+    for(unsigned id = 0; id < threads_ && split; id++) queues_.push_back(std::make_unique<WorkQueue>());
+    splitting_ = split;
+    std::vector<std::thread> helpers;
+    for(unsigned id = 1; id < threads_; id++){
+        helpers.emplace_back([=]{
+            if(split) splitWorker(id);
+            else helperSearch(board, id, maxDepth, endTime);
+            nodes_ += threadNodes_;
+            qnodes_ += threadQNodes_;
+        });
+    }
+
     int depth = 1;
-    while(depth < 50){
+    while(depth <= maxDepth){
         std::cout << "\n DEPTH: " << depth << '\n';
         value = negaMax(board, depth, alpha, beta, endTime, pv);
-        if(time(nullptr) > endTime) break;
+        if(stopped(endTime)) break;
         if(pv.isMate()) break;
         depth++;
     }
+
+    stop_ = true;
+    for(std::thread& helper : helpers) helper.join();
+    // with the helpers gone a search called directly must not stop right away
+    stop_ = false;
+    splitting_ = false;
+    nodes_ += threadNodes_;
+    qnodes_ += threadQNodes_;
     return value;
 }
 
@@ -238,37 +586,3 @@ void NegaMax::printBoardWithPossibleMoves(Board& board, Board::MoveVec& generate
     std::cout << "Possible moves: \n"; board.printPossibleMoves(board, generatedMovesSet);
     std::cout << "-------------------------------" << '\n';
 }
-
-void NegaMax::initZobristTable(unsigned long long int (&zobristTable)[64][12]){
-    std::mt19937 mt(01234567);
-    for (int index = 0; index<64; index++){
-        for (int k = 0; k<12; k++){
-        std::uniform_int_distribution<unsigned long long int> dist(0, UINT64_MAX);
-          zobristTable[index][k] = dist(mt);;
-      }
-    }
-}
-
-long long unsigned int NegaMax::computeZobristHash(long long unsigned int (&zobristTable)[64][12], Board& board)
-{
-    unsigned long long int hash = 0;
-    for (auto const& [key, val] : board.pieceMap()){
-        Piece piece = *val;
-        int pieceIndex = piece.zobristIndexOf();
-        hash ^= zobristTable[key][pieceIndex];
-    }
-    return hash;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
@@ -7,24 +7,59 @@
 #include <optional>
 #include <iosfwd>
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include "PrincipalVariation.hpp"
 #include <optional>
 
-struct BoardStruct;
-
 class NegaMax {
 public:
-    static int negaMax(Board board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, std::optional<Square> from = std::nullopt);
-    static int negamaxSearch(Board board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional<Square> from = std::nullopt);
-    static int iterativeDeepening(Board board, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional<Square> from = std::nullopt);
+    // how the search plays and takes back moves
+    enum class MoveMaking {
+        MakeUnmake, // Board::makeMove and Board::reverseMove on one board
+        CopyMake    // doMove on a copy of the position, the original is put back afterwards
+    };
+
+    static void setMoveMaking(MoveMaking moveMaking);
+    static MoveMaking moveMaking();
+
+    // the transposition table kept between searches, resizing or clearing drops its entries
+    static constexpr std::size_t DefaultHashMegabytes = 16;
+    static void setHashSize(std::size_t megabytes);
+    static void clearHash();
+
+    // threads searching the same position in iterativeDeepening, all but one of them helpers
+    static void setThreads(unsigned threads);
+    static unsigned threads();
+
+    // how the helper threads take part in the search
+    enum class ParallelSearch {
+        LazySmp,          // every helper searches the whole tree, they only share the transposition table
+        YoungBrothersWait // after the first move of a node its siblings are split off to idle helpers
+    };
+
+    static void setParallelSearch(ParallelSearch parallelSearch);
+    static ParallelSearch parallelSearch();
+    // positions visited by the main search of all threads in the last iterativeDeepening
+    static std::uint64_t nodes();
+    // positions visited by the quiescence search of all threads in the last iterativeDeepening
+    static std::uint64_t qnodes();
+
+    static int negaMax(Board& board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, std::optional<Square> from = std::nullopt);
+    static int negamaxSearch(Board& board, int depth, int alpha, int beta, time_t endTime, PrincipalVariation& pv, const std::optional<Square> from = std::nullopt);
+    // the score of a leaf once only captures are left, and every evasion when in check
+    static int quiescence(Board& board, int alpha, int beta, time_t endTime, PrincipalVariation& pv);
+    static constexpr int MaxDepth = 49;
+    // the score of being mated at the root, being mated n plies later scores n more
+    static constexpr int Mate = std::numeric_limits<int>::max();
+    static int iterativeDeepening(Board board, int alpha, int beta, time_t endTime, PrincipalVariation& pv,
+                                  const std::optional<Square> from = std::nullopt, int maxDepth = MaxDepth);
     
     static void generatePseudoLegalMoves(Board& board, Board::MoveVec& generatedMoves, bool changeColor, std::optional<Square> from = std::nullopt);
     static void filterLegalMovesFromPseudoLegalMoves(Board& board, Board::MoveVec& generatedMoves, Board::MoveVec& generatedLegalMoves);
     static void printBoardWithPossibleMoves(Board& board, Board::MoveVec& generatedMoves);
     
-    static void initZobristTable(unsigned long long int (&zobristTable)[64][12]);
-    static unsigned long long int computeZobristHash(unsigned long long int (&zobristTable)[64][12], Board& board);
-    
     //static time_t currentTime;
     //static time_t endTime;
 };
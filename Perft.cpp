@@ -0,0 +1,129 @@
+#include "Perft.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <time.h>
+#endif
+
+Perft::Cache::Cache(std::size_t megabytes) {
+    // the largest power of two number of entries that fits
+    std::size_t count = 1;
+    while(count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) count *= 2;
+    // value-initialized, an all-zero entry never matches since depths below 2 are not stored
+    entries_ = std::make_unique<Entry[]>(count);
+    mask_ = count - 1;
+}
+
+bool Perft::Cache::probe(Zobrist::Key key, int depth, std::uint64_t& nodes) const {
+    const Entry& entry = entries_[key & mask_];
+    std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+    std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+    if((check ^ data) != key || (int) (data & 0xFF) != depth) return false;
+    nodes = data >> 8;
+    return true;
+}
+
+void Perft::Cache::store(Zobrist::Key key, int depth, std::uint64_t nodes) {
+    Entry& entry = entries_[key & mask_];
+    std::uint64_t data = nodes << 8 | (std::uint64_t) depth;
+    entry.check.store(key ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+// processor time used by the calling thread, wall time where that is not available.
+// threads sharing a core each only get part of the wall time, so this measures the speed of one thread
+static double threadSeconds() {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#else
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+std::uint64_t Perft::count(Board& board, int depth, Cache* cache) {
+    if(depth <= 0) return 1;
+    Board::MoveVec moves;
+    board.legalMoves(moves);
+    // bulk counting: every legal move at the last ply is a leaf
+    if(depth == 1) return moves.size();
+
+    std::uint64_t nodes = 0;
+    if(cache != nullptr && cache->probe(board.key(), depth, nodes)) return nodes;
+
+    for(const Move& move: moves){
+        board.makeMove(move);
+        nodes += count(board, depth - 1, cache);
+        board.reverseMove(move);
+    }
+    if(cache != nullptr) cache->store(board.key(), depth, nodes);
+    return nodes;
+}
+
+std::uint64_t Perft::divide(Board& board, int depth, std::ostream& os, unsigned threads, std::size_t hashMegabytes) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+
+    if(depth <= 0){
+        os << "\nNodes searched: 1\n";
+        return 1;
+    }
+
+    std::unique_ptr<Cache> cache;
+    if(hashMegabytes > 0) cache = std::make_unique<Cache>(hashMegabytes);
+
+    Board::MoveVec moves;
+    board.legalMoves(moves);
+    threads = std::max(1u, std::min<unsigned>(threads, moves.size()));
+
+    // root moves are handed out one at a time, so threads that get small subtrees take more of them
+    std::vector<std::uint64_t> moveNodes(moves.size(), 0);
+    std::vector<std::uint64_t> threadNodes(threads, 0);
+    std::vector<double> threadTimes(threads, 0);
+    std::atomic<std::size_t> nextMove(0);
+
+    auto work = [&](unsigned id) {
+        double threadStart = threadSeconds();
+        Board local = board;
+        for(std::size_t i = nextMove++; i < moves.size(); i = nextMove++){
+            local.makeMove(moves[i]);
+            moveNodes[i] = count(local, depth - 1, cache.get());
+            local.reverseMove(moves[i]);
+            threadNodes[id] += moveNodes[i];
+        }
+        threadTimes[id] = threadSeconds() - threadStart;
+    };
+
+    std::vector<std::thread> workers;
+    for(unsigned id = 1; id < threads; id++) workers.emplace_back(work, id);
+    work(0);
+    for(std::thread& worker: workers) worker.join();
+
+    std::uint64_t nodes = 0;
+    for(std::size_t i = 0; i < moves.size(); i++){
+        os << moves[i] << ": " << moveNodes[i] << '\n';
+        nodes += moveNodes[i];
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    os << "\nNodes searched: " << nodes << '\n';
+    os << "Time: " << (std::uint64_t) (seconds * 1000) << " ms";
+    if(seconds > 0) os << " (" << (std::uint64_t) (nodes / seconds) << " nps)";
+    os << '\n';
+
+    // the speedup over one thread needs a run on one thread for reference, that is Bench::perftScaling
+    if(threads > 1){
+        for(unsigned id = 0; id < threads; id++){
+            os << "Thread " << id << ": " << threadNodes[id] << " nodes";
+            if(threadTimes[id] > 0) os << " (" << (std::uint64_t) (threadNodes[id] / threadTimes[id]) << " nps)";
+            os << '\n';
+        }
+    }
+    return nodes;
+}
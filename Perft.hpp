@@ -0,0 +1,45 @@
+#ifndef CHESS_ENGINE_PERFT_HPP
+#define CHESS_ENGINE_PERFT_HPP
+
+#include "Board.hpp"
+#include "Zobrist.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+
+// Counts the leaf nodes of the legal move tree to validate and time move generation
+// together with makeMove and reverseMove, independent of the search.
+class Perft {
+public:
+    // Node counts of subtrees, shared by all threads without locks. An entry stores its
+    // data and its key XOR its data, so an entry torn by concurrent writes fails the check.
+    class Cache {
+    public:
+        explicit Cache(std::size_t megabytes);
+
+        bool probe(Zobrist::Key key, int depth, std::uint64_t& nodes) const;
+        void store(Zobrist::Key key, int depth, std::uint64_t nodes);
+
+    private:
+        struct Entry {
+            std::atomic<std::uint64_t> check;
+            std::atomic<std::uint64_t> data; // nodes << 8 | depth
+        };
+
+        std::unique_ptr<Entry[]> entries_;
+        std::size_t mask_;
+    };
+
+    // leaf nodes depth plies below board, the last ply is counted without making its moves
+    static std::uint64_t count(Board& board, int depth, Cache* cache = nullptr);
+
+    // like count, but also reports the nodes below every root move, the total and the speed to os.
+    // with more than one thread the root moves are shared out, each thread searching its own copy of board.
+    // a cache of hashMegabytes is shared between the threads, none is used for 0.
+    static std::uint64_t divide(Board& board, int depth, std::ostream& os, unsigned threads = 1, std::size_t hashMegabytes = 0);
+};
+
+#endif
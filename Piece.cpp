@@ -1,12 +1,10 @@
 #include "Piece.hpp"
 
 #include <ostream>
+#include <type_traits>
 
-Piece::Piece(PieceColor color, PieceType type)
-{
-    color_ = color;
-    type_ = type;
-}
+static_assert(sizeof(Piece) == 1, "Piece should fit in one byte");
+static_assert(std::is_trivially_copyable<Piece>::value, "Piece should be trivially copyable");
 
 Piece::Optional Piece::fromSymbol(char symbol) {
     PieceColor pieceColor = PieceColor::Black;
@@ -38,48 +36,6 @@ std::optional<PieceType> Piece::charToPieceType(char symbol){
     return {};
 }
 
-PieceColor Piece::color() const {
-    return color_;
-}
-
-PieceType Piece::type() const {
-    return type_;
-}
-
-int Piece::zobristIndexOf()
-{
-    if (type()==PieceType::Pawn && color() == PieceColor::White)
-        return 0;
-    if (type()==PieceType::Knight && color() == PieceColor::White)
-        return 1;
-    if (type()==PieceType::Bishop && color() == PieceColor::White)
-        return 2;
-    if (type()==PieceType::Rook && color() == PieceColor::White)
-        return 3;
-    if (type()==PieceType::Queen && color() == PieceColor::White)
-        return 4;
-    if (type()==PieceType::King && color() == PieceColor::White)
-        return 5;
-    if (type()==PieceType::Pawn && color() == PieceColor::Black)
-        return 6;
-    if (type()==PieceType::Knight && color() == PieceColor::Black)
-        return 7;
-    if (type()==PieceType::Bishop && color() == PieceColor::Black)
-        return 8;
-    if (type()==PieceType::Rook && color() == PieceColor::Black)
-        return 9;
-    if (type()==PieceType::Queen && color() == PieceColor::Black)
-        return 10;
-    if (type()==PieceType::King && color() == PieceColor::Black)
-        return 11;
-    else
-        return -1;
-}
-
-bool operator==(const Piece& lhs, const Piece& rhs) {
-    return lhs.color() == rhs.color() && lhs.type() == rhs.type();
-}
-
 std::ostream& operator<<(std::ostream& os, const Piece& piece) {
     bool white = false;
     if (piece.color() == PieceColor::White) white = true;
@@ -99,7 +55,3 @@ std::ostream& operator<<(std::ostream& os, const Piece& piece) {
     }
     return os << "";
 }
-
-PieceColor operator!(PieceColor color) {
-    return color == PieceColor::White ? PieceColor::Black : PieceColor::White;
-}
@@ -1,15 +1,16 @@
 #ifndef CHESS_ENGINE_PIECE_HPP
 #define CHESS_ENGINE_PIECE_HPP
 
+#include <cstdint>
 #include <optional>
 #include <iosfwd>
 
-enum class PieceColor {
+enum class PieceColor : std::uint8_t {
     White,
     Black
 };
 
-enum class PieceType {
+enum class PieceType : std::uint8_t {
     Pawn,
     Knight,
     Bishop,
@@ -23,25 +24,53 @@ public:
 
     using Optional = std::optional<Piece>;
 
-    Piece(PieceColor color, PieceType type);
+    constexpr Piece(PieceColor color, PieceType type);
 
     static Optional fromSymbol(char symbol);
     static std::optional<PieceType> charToPieceType(char symbol);
 
-    PieceColor color() const;
-    PieceType type() const;
-    
-    int zobristIndexOf();
+    // Dense index in [0, 12): White Pawn..King map to 0..5, Black Pawn..King to 6..11.
+    // fromIndex does no bounds check.
+    static constexpr Piece fromIndex(unsigned index);
+    constexpr unsigned index() const;
+
+    constexpr PieceColor color() const;
+    constexpr PieceType type() const;
     
 private:
-    PieceColor color_;
-    PieceType type_;
+    constexpr explicit Piece(std::uint8_t index) : index_(index) {}
+    std::uint8_t index_;
 };
 
-bool operator==(const Piece& lhs, const Piece& rhs);
+constexpr Piece::Piece(PieceColor color, PieceType type)
+    : index_(static_cast<std::uint8_t>(static_cast<unsigned>(color) * 6 + static_cast<unsigned>(type))) {
+}
+
+constexpr Piece Piece::fromIndex(unsigned index) {
+    return Piece(static_cast<std::uint8_t>(index));
+}
+
+constexpr unsigned Piece::index() const {
+    return index_;
+}
+
+constexpr PieceColor Piece::color() const {
+    return index_ >= 6 ? PieceColor::Black : PieceColor::White;
+}
+
+constexpr PieceType Piece::type() const {
+    return static_cast<PieceType>(index_ >= 6 ? index_ - 6 : index_);
+}
+
+constexpr bool operator==(const Piece& lhs, const Piece& rhs) {
+    return lhs.index() == rhs.index();
+}
+
 std::ostream& operator<<(std::ostream& os, const Piece& piece);
 
 // Invert a color (White becomes Black and vice versa)
-PieceColor operator!(PieceColor color);
+constexpr PieceColor operator!(PieceColor color) {
+    return color == PieceColor::White ? PieceColor::Black : PieceColor::White;
+}
 
 #endif
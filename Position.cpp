@@ -0,0 +1,152 @@
+#include "Position.hpp"
+
+#include <algorithm>
+
+void Position::clear() {
+    std::fill(std::begin(byType), std::end(byType), Bitboards::Empty);
+    std::fill(std::begin(byColor), std::end(byColor), Bitboards::Empty);
+    std::fill(std::begin(squares), std::end(squares), NoPiece);
+    key = 0;
+    halfmoveClock = 0;
+    turn = PieceColor::White;
+    castlingRights = CastlingRights::None;
+    enPassantSquare = std::nullopt;
+}
+
+void Position::putPiece(Square square, Piece piece) {
+    Bitboard bb = Bitboards::squareBB(square.index());
+    byType[(int) piece.type()] |= bb;
+    byColor[(int) piece.color()] |= bb;
+    squares[square.index()] = (std::uint8_t) piece.index();
+    key ^= Zobrist::piece(piece, square);
+}
+
+void Position::removePiece(Square square) {
+    std::uint8_t code = squares[square.index()];
+    if(code == NoPiece) return;
+    Piece piece = Piece::fromIndex(code);
+    Bitboard bb = Bitboards::squareBB(square.index());
+    byType[(int) piece.type()] &= ~bb;
+    byColor[(int) piece.color()] &= ~bb;
+    squares[square.index()] = NoPiece;
+    key ^= Zobrist::piece(piece, square);
+}
+
+void Position::movePiece(Square from, Square to) {
+    Piece piece = pieceOn(from);
+    removePiece(from);
+    putPiece(to, piece);
+}
+
+void Position::setTurn(PieceColor color) {
+    if(color != turn) key ^= Zobrist::side();
+    turn = color;
+}
+
+void Position::setCastlingRights(CastlingRights cr) {
+    key ^= Zobrist::castling(castlingRights) ^ Zobrist::castling(cr);
+    castlingRights = cr;
+}
+
+void Position::setEnPassantSquare(Square::Optional square) {
+    if(enPassantSquare.has_value()) key ^= Zobrist::enPassant(*enPassantSquare);
+    if(square.has_value()) key ^= Zobrist::enPassant(*square);
+    enPassantSquare = square;
+}
+
+std::uint8_t Position::applyMove(Move move) {
+    // the mover's color fixes directions and castling squares at compile time
+    if(pieceOn(move.from()).color() == PieceColor::White) return applyMove<PieceColor::White>(move);
+    return applyMove<PieceColor::Black>(move);
+}
+
+template<PieceColor Us>
+std::uint8_t Position::applyMove(Move move) {
+    constexpr int Up = Us == PieceColor::White ? 8 : -8;
+    constexpr Square KingStart = Us == PieceColor::White ? Square::E1 : Square::E8;
+
+    // piece to move, a promotion changes its type
+    PieceType pieceToMoveType = pieceOn(move.from()).type();
+    PieceType newType = move.promotion().value_or(pieceToMoveType);
+
+    /* captures */
+    // a pawn moving to the en passant square captures the pawn behind it, any other move captures on move.to()
+    Square capturedSquare = move.to();
+    if(pieceToMoveType == PieceType::Pawn && enPassantSquare.has_value() && move.to() == *enPassantSquare)
+        capturedSquare = Square::fromIndexUnchecked(move.to().index() - Up);
+    std::uint8_t capturedPiece = squares[capturedSquare.index()];
+    removePiece(capturedSquare);
+
+    // the fifty move counter restarts on captures and pawn moves
+    if(capturedPiece != NoPiece || pieceToMoveType == PieceType::Pawn) halfmoveClock = 0;
+    else halfmoveClock++;
+
+    // erase moving piece from move.from() and set it on move.to()
+    removePiece(move.from());
+    putPiece(move.to(), Piece(Us, newType));
+
+    /* en passant */
+    // enPassantSquare was set => remove after this move
+    if(enPassantSquare.has_value()) setEnPassantSquare(std::nullopt);
+
+    // a double step makes the square it passed over the en passant square for the next move
+    if(pieceToMoveType == PieceType::Pawn && (int) move.to().index() - (int) move.from().index() == 2 * Up)
+        setEnPassantSquare(Square::fromIndexUnchecked(move.from().index() + Up));
+
+    /* castling */
+    // the king moving two files from its start square castles, thus move the rook
+    if(pieceToMoveType == PieceType::King && move.from() == KingStart){
+        if(move.to().index() == KingStart.index() + 2)
+            movePiece(Square::fromIndexUnchecked(KingStart.index() + 3), Square::fromIndexUnchecked(KingStart.index() + 1));
+        else if(move.to().index() + 2 == KingStart.index())
+            movePiece(Square::fromIndexUnchecked(KingStart.index() - 4), Square::fromIndexUnchecked(KingStart.index() - 1));
+    }
+    // update castling rights
+    updateCastlingRights(move);
+
+    //switch turn
+    setTurn(!turn);
+    return capturedPiece;
+}
+
+template std::uint8_t Position::applyMove<PieceColor::White>(Move move);
+template std::uint8_t Position::applyMove<PieceColor::Black>(Move move);
+
+// castling rights that remain when a piece moves from or to the given square index
+static CastlingRights castlingRightsMask(unsigned index){
+    switch(index){
+        case Square::A1.index(): return ~CastlingRights::WhiteQueenside;
+        case Square::E1.index(): return ~CastlingRights::White;
+        case Square::H1.index(): return ~CastlingRights::WhiteKingside;
+        case Square::A8.index(): return ~CastlingRights::BlackQueenside;
+        case Square::E8.index(): return ~CastlingRights::Black;
+        case Square::H8.index(): return ~CastlingRights::BlackKingside;
+        default: return CastlingRights::All;
+    }
+}
+
+void Position::updateCastlingRights(Move move){
+    // Rule 1: king and rook can not have moved already: a king or rook leaving its start square
+    //         (or a rook being captured on it) permanently removes the matching rights.
+    // Rule 2-4 (no pieces in between, no attacked squares) depend on the position and are checked by move generation.
+    setCastlingRights(castlingRights & castlingRightsMask(move.from().index()) & castlingRightsMask(move.to().index()));
+}
+
+Zobrist::Key Position::computeKey() const {
+    Zobrist::Key result = 0;
+    Bitboard occupied = pieces();
+    while(occupied){
+        Square square = Square::fromIndexUnchecked(Bitboards::popLsb(occupied));
+        result ^= Zobrist::piece(pieceOn(square), square);
+    }
+    if(turn == PieceColor::Black) result ^= Zobrist::side();
+    result ^= Zobrist::castling(castlingRights);
+    if(enPassantSquare.has_value()) result ^= Zobrist::enPassant(*enPassantSquare);
+    return result;
+}
+
+Position doMove(const Position& position, Move move) {
+    Position result = position;
+    result.applyMove(move);
+    return result;
+}
@@ -0,0 +1,64 @@
+#ifndef CHESS_ENGINE_POSITION_HPP
+#define CHESS_ENGINE_POSITION_HPP
+
+#include "Piece.hpp"
+#include "Square.hpp"
+#include "Move.hpp"
+#include "CastlingRights.hpp"
+#include "Bitboard.hpp"
+#include "Zobrist.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+// The complete state of a position as plain data. It is cheap to copy, so the
+// search can either make and reverse moves on a Board or copy a Position per node.
+struct Position {
+    // piece code of an empty square
+    static constexpr std::uint8_t NoPiece = 12;
+
+    // bitboard per piece type and per color, plus a piece code per square
+    Bitboard byType[6];
+    Bitboard byColor[2];
+    std::uint8_t squares[64];
+    Zobrist::Key key;
+    std::uint16_t halfmoveClock;
+    PieceColor turn;
+    CastlingRights castlingRights;
+    Square::Optional enPassantSquare;
+
+    // reset to an empty board with white to move
+    void clear();
+
+    Bitboard pieces() const { return byColor[0] | byColor[1]; }
+    Bitboard pieces(PieceColor color) const { return byColor[(int) color]; }
+    Bitboard pieces(PieceType type) const { return byType[(int) type]; }
+    Bitboard pieces(PieceType type, PieceColor color) const { return byType[(int) type] & byColor[(int) color]; }
+    bool isEmpty(Square square) const { return squares[square.index()] == NoPiece; }
+    Piece pieceOn(Square square) const { return Piece::fromIndex(squares[square.index()]); }
+
+    // all of these keep the key up to date
+    void putPiece(Square square, Piece piece);
+    void removePiece(Square square);
+    void movePiece(Square from, Square to);
+    void setTurn(PieceColor color);
+    void setCastlingRights(CastlingRights cr);
+    void setEnPassantSquare(Square::Optional square);
+
+    // play move in place and return the code of the captured piece (NoPiece if none)
+    std::uint8_t applyMove(Move move);
+    // the same for a move of a piece of color Us
+    template<PieceColor Us>
+    std::uint8_t applyMove(Move move);
+    void updateCastlingRights(Move move);
+
+    Zobrist::Key computeKey() const;
+};
+
+static_assert(std::is_trivially_copyable_v<Position>, "Position must stay plain data");
+static_assert(sizeof(Position) < 200, "Position must stay cheap to copy");
+
+// copy-make: the position after playing move on position
+Position doMove(const Position& position, Move move);
+
+#endif
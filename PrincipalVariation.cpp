@@ -47,17 +47,12 @@ int PrincipalVariation::score() const {
             testBoard.makeMove(move);
         }
     }*/
-    // generate pseudo legal moves for own color
-    Board::MoveVec generatedMovesBoardColor = Board::MoveVec();
-    testBoard.pseudoLegalMoves(generatedMovesBoardColor);
-    
-    // generate pseudo legal moves for opposing color
-    Board::MoveVec generatedMovesOtherColor = Board::MoveVec();
-    testBoard.pseudoLegalMoves(generatedMovesOtherColor);
-    
-    if(testBoard.isStaleMate(generatedMovesOtherColor)) return 0;
+    // stalemate: no legal moves without being in check
+    Board::MoveVec legalMoves = Board::MoveVec();
+    testBoard.legalMoves(legalMoves);
+    if(legalMoves.empty()) return 0;
 
-    return testBoard.evaluate(generatedMovesBoardColor, generatedMovesOtherColor);
+    return testBoard.evaluate();
 }
 
 std::size_t PrincipalVariation::length() const {
@@ -8,6 +8,7 @@
 #include <iosfwd>
 #include <cstddef>
 #include <vector>
+#include <memory>
 
 class PrincipalVariation {
 public:
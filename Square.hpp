@@ -1,6 +1,7 @@
 #ifndef CHESS_ENGINE_SQUARE_HPP
 #define CHESS_ENGINE_SQUARE_HPP
 
+#include <cstdint>
 #include <optional>
 #include <iosfwd>
 #include <string>
@@ -12,13 +13,18 @@ public:
     using Index = unsigned;
     using Optional = std::optional<Square>;
 
-    static Optional fromCoordinates(Coordinate file, Coordinate rank);
-    static Optional fromIndex(Index index);
+    static constexpr Optional fromCoordinates(Coordinate file, Coordinate rank);
+    static constexpr Optional fromIndex(Index index);
     static Optional fromName(const std::string& name);
 
-    Coordinate file() const;
-    Coordinate rank() const;
-    Index index() const;
+    // Unchecked versions for hot paths (e.g., move generation): the caller guarantees
+    // that the index is in [0, 64) and that file and rank are in [0, 8).
+    static constexpr Square fromIndexUnchecked(Index index);
+    static constexpr Square fromCoordinatesUnchecked(Coordinate file, Coordinate rank);
+
+    constexpr Coordinate file() const;
+    constexpr Coordinate rank() const;
+    constexpr Index index() const;
 
     static const Square A1, B1, C1, D1, E1, F1, G1, H1;
     static const Square A2, B2, C2, D2, E2, F2, G2, H2;
@@ -30,16 +36,121 @@ public:
     static const Square A8, B8, C8, D8, E8, F8, G8, H8;
 
 private:
-    Square(Index index);
-    Index index_;
-    Coordinate file_;
-    Coordinate rank_;
+    constexpr explicit Square(Index index) : index_(static_cast<std::uint8_t>(index)) {}
+    std::uint8_t index_;
 };
 
+constexpr Square::Optional Square::fromCoordinates(Coordinate file, Coordinate rank) {
+    if (file > 7 || rank > 7) return std::nullopt;
+    return Square(rank * 8 + file);
+}
+
+constexpr Square::Optional Square::fromIndex(Index index) {
+    if (index > 63) return std::nullopt;
+    return Square(index);
+}
+
+constexpr Square Square::fromIndexUnchecked(Index index) {
+    return Square(index);
+}
+
+constexpr Square Square::fromCoordinatesUnchecked(Coordinate file, Coordinate rank) {
+    return Square(rank * 8 + file);
+}
+
+constexpr Square::Coordinate Square::file() const {
+    return index_ & 7;
+}
+
+constexpr Square::Coordinate Square::rank() const {
+    return index_ >> 3;
+}
+
+constexpr Square::Index Square::index() const {
+    return index_;
+}
+
+inline constexpr Square Square::A1 = Square( 0 + 0);
+inline constexpr Square Square::B1 = Square( 0 + 1);
+inline constexpr Square Square::C1 = Square( 0 + 2);
+inline constexpr Square Square::D1 = Square( 0 + 3);
+inline constexpr Square Square::E1 = Square( 0 + 4);
+inline constexpr Square Square::F1 = Square( 0 + 5);
+inline constexpr Square Square::G1 = Square( 0 + 6);
+inline constexpr Square Square::H1 = Square( 0 + 7);
+
+inline constexpr Square Square::A2 = Square( 8 + 0);
+inline constexpr Square Square::B2 = Square( 8 + 1);
+inline constexpr Square Square::C2 = Square( 8 + 2);
+inline constexpr Square Square::D2 = Square( 8 + 3);
+inline constexpr Square Square::E2 = Square( 8 + 4);
+inline constexpr Square Square::F2 = Square( 8 + 5);
+inline constexpr Square Square::G2 = Square( 8 + 6);
+inline constexpr Square Square::H2 = Square( 8 + 7);
+
+inline constexpr Square Square::A3 = Square(16 + 0);
+inline constexpr Square Square::B3 = Square(16 + 1);
+inline constexpr Square Square::C3 = Square(16 + 2);
+inline constexpr Square Square::D3 = Square(16 + 3);
+inline constexpr Square Square::E3 = Square(16 + 4);
+inline constexpr Square Square::F3 = Square(16 + 5);
+inline constexpr Square Square::G3 = Square(16 + 6);
+inline constexpr Square Square::H3 = Square(16 + 7);
+
+inline constexpr Square Square::A4 = Square(24 + 0);
+inline constexpr Square Square::B4 = Square(24 + 1);
+inline constexpr Square Square::C4 = Square(24 + 2);
+inline constexpr Square Square::D4 = Square(24 + 3);
+inline constexpr Square Square::E4 = Square(24 + 4);
+inline constexpr Square Square::F4 = Square(24 + 5);
+inline constexpr Square Square::G4 = Square(24 + 6);
+inline constexpr Square Square::H4 = Square(24 + 7);
+
+inline constexpr Square Square::A5 = Square(32 + 0);
+inline constexpr Square Square::B5 = Square(32 + 1);
+inline constexpr Square Square::C5 = Square(32 + 2);
+inline constexpr Square Square::D5 = Square(32 + 3);
+inline constexpr Square Square::E5 = Square(32 + 4);
+inline constexpr Square Square::F5 = Square(32 + 5);
+inline constexpr Square Square::G5 = Square(32 + 6);
+inline constexpr Square Square::H5 = Square(32 + 7);
+
+inline constexpr Square Square::A6 = Square(40 + 0);
+inline constexpr Square Square::B6 = Square(40 + 1);
+inline constexpr Square Square::C6 = Square(40 + 2);
+inline constexpr Square Square::D6 = Square(40 + 3);
+inline constexpr Square Square::E6 = Square(40 + 4);
+inline constexpr Square Square::F6 = Square(40 + 5);
+inline constexpr Square Square::G6 = Square(40 + 6);
+inline constexpr Square Square::H6 = Square(40 + 7);
+
+inline constexpr Square Square::A7 = Square(48 + 0);
+inline constexpr Square Square::B7 = Square(48 + 1);
+inline constexpr Square Square::C7 = Square(48 + 2);
+inline constexpr Square Square::D7 = Square(48 + 3);
+inline constexpr Square Square::E7 = Square(48 + 4);
+inline constexpr Square Square::F7 = Square(48 + 5);
+inline constexpr Square Square::G7 = Square(48 + 6);
+inline constexpr Square Square::H7 = Square(48 + 7);
+
+inline constexpr Square Square::A8 = Square(56 + 0);
+inline constexpr Square Square::B8 = Square(56 + 1);
+inline constexpr Square Square::C8 = Square(56 + 2);
+inline constexpr Square Square::D8 = Square(56 + 3);
+inline constexpr Square Square::E8 = Square(56 + 4);
+inline constexpr Square Square::F8 = Square(56 + 5);
+inline constexpr Square Square::G8 = Square(56 + 6);
+inline constexpr Square Square::H8 = Square(56 + 7);
+
 std::ostream& operator<<(std::ostream& os, const Square& square);
 
 // Necessary to support Square as the key in std::map.
-bool operator<(const Square& lhs, const Square& rhs);
-bool operator==(const Square& lhs, const Square& rhs);
+constexpr bool operator<(const Square& lhs, const Square& rhs) {
+    return lhs.index() < rhs.index();
+}
+
+constexpr bool operator==(const Square& lhs, const Square& rhs) {
+    return lhs.index() == rhs.index();
+}
 
 #endif
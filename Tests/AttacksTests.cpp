@@ -0,0 +1,94 @@
+#include "catch2/catch.hpp"
+
+#include "Attacks.hpp"
+
+#include <cstdint>
+
+TEST_CASE("Table slider attacks match walking the rays", "[Attacks]") {
+    auto indexing = GENERATE(Attacks::Indexing::Magic, Attacks::Indexing::Pext);
+
+    if (indexing == Attacks::Indexing::Pext && !Attacks::pextSupported()) {
+        REQUIRE_FALSE(Attacks::setIndexing(indexing));
+        return;
+    }
+
+    auto previous = Attacks::indexing();
+    REQUIRE(Attacks::setIndexing(indexing));
+
+    std::uint64_t state = 0x123456789ABCDEFULL;
+    auto random = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    for (auto index = 0u; index < 64; ++index) {
+        auto square = Square::fromIndexUnchecked(index);
+
+        for (auto i = 0; i < 100; ++i) {
+            // sparse and dense occupancies
+            Bitboard occupied = i % 2 == 0 ? random() & random() : random() | random();
+            CAPTURE(index, occupied);
+
+            auto rook = Attacks::slidingAttacks(PieceType::Rook, square, occupied);
+            auto bishop = Attacks::slidingAttacks(PieceType::Bishop, square, occupied);
+            REQUIRE(Attacks::rook(square, occupied) == rook);
+            REQUIRE(Attacks::bishop(square, occupied) == bishop);
+            REQUIRE(Attacks::queen(square, occupied) == (rook | bishop));
+        }
+    }
+
+    Attacks::setIndexing(previous);
+}
+
+TEST_CASE("Slider attacks stop at the first blocker", "[Attacks]") {
+    Bitboard occupied = Bitboards::squareBB(Square::D6.index()) | Bitboards::squareBB(Square::F4.index());
+    Bitboard expected = Bitboards::Empty;
+
+    for (auto square : {Square::D5, Square::D6, Square::D3, Square::D2, Square::D1,
+                        Square::A4, Square::B4, Square::C4, Square::E4, Square::F4}) {
+        expected |= Bitboards::squareBB(square.index());
+    }
+
+    REQUIRE(Attacks::rook(Square::D4, occupied) == expected);
+}
+
+TEST_CASE("Filled attacks of many sliders match the table attacks", "[Attacks]") {
+    auto fill = GENERATE(Attacks::Fill::Scalar, Attacks::Fill::Avx2);
+
+    if (fill == Attacks::Fill::Avx2 && !Attacks::avx2Supported()) {
+        REQUIRE_FALSE(Attacks::setFill(fill));
+        return;
+    }
+
+    auto previous = Attacks::fill();
+    REQUIRE(Attacks::setFill(fill));
+
+    std::uint64_t state = 0xFEDCBA9876543210ULL;
+    auto random = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    for (auto i = 0; i < 1000; ++i) {
+        Bitboard occupied = i % 2 == 0 ? random() & random() : random() | random();
+        // the sliders are part of the occupancy, some of them in both sets like queens
+        Bitboard rooks = occupied & random() & random();
+        Bitboard bishops = occupied & random() & random();
+        CAPTURE(occupied, rooks, bishops);
+
+        Bitboard expected = Bitboards::Empty;
+        for (Bitboard bb = rooks; bb;) {
+            expected |= Attacks::rook(Square::fromIndexUnchecked(Bitboards::popLsb(bb)), occupied);
+        }
+        for (Bitboard bb = bishops; bb;) {
+            expected |= Attacks::bishop(Square::fromIndexUnchecked(Bitboards::popLsb(bb)), occupied);
+        }
+        REQUIRE(Attacks::sliders(rooks, bishops, occupied) == expected);
+    }
+
+    Attacks::setFill(previous);
+}
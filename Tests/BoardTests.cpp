@@ -994,3 +994,380 @@ TEST_CASE_PSEUDO_MOVES("Pseudo-legal moves, multiple pieces, black", "") {
         }
     );
 }
+
+TEST_CASE("Reversing a move restores the board exactly", "[Board][MoveMaking][Zobrist]") {
+    auto fen = GENERATE(
+        // https://lichess.org/editor/r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R_w_KQkq_-_0_1
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        // https://lichess.org/editor/8/8/8/3pPp2/8/8/8/8_w_-_d6_0_1
+        "8/8/8/3pPp2/8/8/8/8 w - d6 4 1",
+        // https://lichess.org/editor/r3k2r/1P6/8/8/8/8/6p1/R3K2R_b_KQkq_-_7_20
+        "r3k2r/1P6/8/8/8/8/6p1/R3K2R b KQkq - 7 20"
+    );
+
+    auto board = Fen::createBoard(fen).value();
+    auto key = board.key();
+    REQUIRE(key == board.computeKey());
+
+    Board::MoveVec moves;
+    board.pseudoLegalMoves(moves);
+
+    for (auto move : moves) {
+        CAPTURE(move);
+        auto before = board;
+        board.makeMove(move);
+        REQUIRE(board.key() != key);
+        REQUIRE(board.key() == board.computeKey());
+        board.reverseMove(move);
+
+        REQUIRE(board.key() == key);
+        REQUIRE(board.turn() == before.turn());
+        REQUIRE(board.castlingRights() == before.castlingRights());
+        REQUIRE(board.enPassantSquare() == before.enPassantSquare());
+        REQUIRE(board.halfmoveClock() == before.halfmoveClock());
+        for (auto i = 0; i < 64; ++i) {
+            auto square = Square::fromIndexUnchecked(i);
+            REQUIRE(board.piece(square) == before.piece(square));
+        }
+    }
+}
+
+TEST_CASE("Every move of a long game can be reversed, also on a copy", "[Board][MoveMaking]") {
+    auto board = Fen::createBoard(Fen::StartingPos).value();
+    auto start = board.key();
+    auto moves = std::vector<Move>();
+    for (auto i = 0; i < 100; ++i) {
+        for (auto uci : {"g1f3", "g8f6", "f3g1", "f6g8"}) {
+            moves.push_back(Move::fromUci(uci).value());
+            board.makeMove(moves.back());
+        }
+    }
+
+    // the copy takes back everything played before it was made
+    auto copy = board;
+    copy.makeMove(Move::fromUci("e2e4").value());
+    copy.reverseMove(Move::fromUci("e2e4").value());
+    for (auto it = moves.rbegin(); it != moves.rend(); ++it) {
+        board.reverseMove(*it);
+        copy.reverseMove(*it);
+    }
+    REQUIRE(board.key() == start);
+    REQUIRE(copy.key() == start);
+    REQUIRE(board.halfmoveClock() == 0);
+}
+
+TEST_CASE("Transpositions have the same Zobrist key", "[Board][Zobrist]") {
+    auto board1 = Fen::createBoard(Fen::StartingPos).value();
+    auto board2 = Fen::createBoard(Fen::StartingPos).value();
+
+    board1.makeMove(Move(Square::G1, Square::F3));
+    board1.makeMove(Move(Square::G8, Square::F6));
+    board1.makeMove(Move(Square::B1, Square::C3));
+
+    board2.makeMove(Move(Square::B1, Square::C3));
+    board2.makeMove(Move(Square::G8, Square::F6));
+    board2.makeMove(Move(Square::G1, Square::F3));
+
+    REQUIRE(board1.key() == board2.key());
+}
+
+TEST_CASE("The Zobrist key depends on turn, castling rights and en passant", "[Board][Zobrist]") {
+    auto board = Fen::createBoard("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1").value();
+    auto key = board.key();
+
+    board.setTurn(PieceColor::Black);
+    REQUIRE(board.key() != key);
+    board.setTurn(PieceColor::White);
+    REQUIRE(board.key() == key);
+
+    board.removeCastlingRights(CastlingRights::WhiteQueenside);
+    REQUIRE(board.key() != key);
+    board.addCastlingRights(CastlingRights::WhiteQueenside);
+    REQUIRE(board.key() == key);
+
+    board.setEnPassantSquare(Square::E3);
+    REQUIRE(board.key() != key);
+    board.setEnPassantSquare(std::nullopt);
+    REQUIRE(board.key() == key);
+}
+
+TEST_CASE("Copy-make gives the same position as make/unmake", "[Board][MoveMaking]") {
+    // https://lichess.org/editor/r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R_w_KQkq_-_0_1
+    auto board = Fen::createBoard("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1").value();
+    auto position = board.position();
+
+    Board::MoveVec moves;
+    board.pseudoLegalMoves(moves);
+
+    for (auto move : moves) {
+        CAPTURE(move);
+        auto child = doMove(position, move);
+        board.makeMove(move);
+
+        REQUIRE(child.key == board.key());
+        REQUIRE(child.key == child.computeKey());
+        REQUIRE(std::equal(std::begin(child.squares), std::end(child.squares), std::begin(board.position().squares)));
+        REQUIRE(child.castlingRights == board.castlingRights());
+        REQUIRE(child.enPassantSquare == board.enPassantSquare());
+
+        board.reverseMove(move);
+    }
+}
+
+static void testLegalMoves(const char* fen, const std::vector<std::string>& expectedUcis) {
+    using MoveSet = std::set<Move>;
+
+    auto board = Fen::createBoard(fen).value();
+
+    auto expectedMoves = MoveSet();
+    for (const auto& uci : expectedUcis) {
+        auto optMove = Move::fromUci(uci);
+        REQUIRE(optMove.has_value());
+        expectedMoves.insert(optMove.value());
+    }
+
+    auto generatedMovesVec = Board::MoveVec();
+    board.legalMoves(generatedMovesVec);
+    auto generatedMoves = MoveSet(generatedMovesVec.begin(), generatedMovesVec.end());
+
+    CAPTURE(fen, generatedMoves, expectedMoves);
+    REQUIRE(generatedMovesVec.size() == generatedMoves.size());
+    REQUIRE(generatedMoves == expectedMoves);
+}
+
+#define TEST_CASE_LEGAL_MOVES(name, tag) \
+    TEST_CASE(name, "[Board][MoveGen][Legal]" tag)
+
+TEST_CASE_LEGAL_MOVES("Legal moves, pinned pieces move along the pin", "[Pin]") {
+    testLegalMoves(
+        // https://lichess.org/editor/4r2k/8/8/8/4R3/8/3N4/4K3_w_-_-_0_1
+        "4r2k/8/8/8/4R3/8/3N4/4K3 w - - 0 1",
+        {
+            "e4e2", "e4e3", "e4e5", "e4e6", "e4e7", "e4e8",
+            "d2b1", "d2b3", "d2c4", "d2f3", "d2f1",
+            "e1d1", "e1f1", "e1f2", "e1e2"
+        }
+    );
+}
+
+TEST_CASE_LEGAL_MOVES("Legal moves, check evasions", "[Check]") {
+    testLegalMoves(
+        // https://lichess.org/editor/4k3/8/8/8/1b6/8/8/RN2K3_w_-_-_0_1
+        "4k3/8/8/8/1b6/8/8/RN2K3 w - - 0 1",
+        {
+            "b1c3", "b1d2",
+            "e1d1", "e1e2", "e1f1", "e1f2"
+        }
+    );
+}
+
+TEST_CASE_LEGAL_MOVES("Legal moves, double check only allows king moves", "[Check]") {
+    testLegalMoves(
+        // https://lichess.org/editor/4k3/8/8/8/1b6/8/3P4/R3K1r1_w_-_-_0_1
+        "4k3/8/8/8/1b6/8/3P4/R3K1r1 w - - 0 1",
+        {
+            "e1e2", "e1f2"
+        }
+    );
+}
+
+TEST_CASE_LEGAL_MOVES("Legal moves, en passant exposing the king on its rank", "[EnPassant]") {
+    testLegalMoves(
+        // https://lichess.org/editor/8/8/8/KPp4r/8/8/8/7k_w_-_c6_0_1
+        "8/8/8/KPp4r/8/8/8/7k w - c6 0 1",
+        {
+            "b5b6",
+            "a5a4", "a5a6", "a5b6"
+        }
+    );
+}
+
+TEST_CASE_LEGAL_MOVES("Legal moves, en passant capturing the checking pawn", "[EnPassant]") {
+    testLegalMoves(
+        // https://lichess.org/editor/8/8/8/3pP3/4K3/8/8/k7_w_-_d6_0_1
+        "8/8/8/3pP3/4K3/8/8/k7 w - d6 0 1",
+        {
+            "e5d6",
+            "e4d3", "e4d4", "e4d5", "e4e3", "e4f3", "e4f4", "e4f5"
+        }
+    );
+}
+
+TEST_CASE_LEGAL_MOVES("Legal moves, no castling through attacked squares", "[Castling]") {
+    testLegalMoves(
+        // https://lichess.org/editor/k4r2/8/8/8/8/8/8/R3K2R_w_KQ_-_0_1
+        "k4r2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        {
+            "e1c1", "e1d1", "e1d2", "e1e2",
+            "a1a2", "a1a3", "a1a4", "a1a5", "a1a6", "a1a7", "a1a8", "a1b1", "a1c1", "a1d1",
+            "h1h2", "h1h3", "h1h4", "h1h5", "h1h6", "h1h7", "h1h8", "h1g1", "h1f1"
+        }
+    );
+}
+
+TEST_CASE("Attackers of a square are found for both colors", "[Board][Attacks]") {
+    // https://lichess.org/editor/4k3/4r3/8/4p3/3P4/5N2/1B6/4K3_w_-_-_0_1
+    auto board = Fen::createBoard("4k3/4r3/8/4p3/3P4/5N2/1B6/4K3 w - - 0 1").value();
+    auto expected = Bitboards::squareBB(Square::D4.index())
+                  | Bitboards::squareBB(Square::F3.index())
+                  | Bitboards::squareBB(Square::E7.index());
+
+    REQUIRE(board.attackersTo(Square::E5) == expected);
+    REQUIRE(board.isSquareAttacked(Square::E5, PieceColor::White));
+    REQUIRE(board.isSquareAttacked(Square::E5, PieceColor::Black));
+    REQUIRE_FALSE(board.isSquareAttacked(Square::A8, PieceColor::White));
+
+    // the bishop behind the pawn joins once the pawn is taken out of the occupancy
+    auto occupied = board.pieces() & ~Bitboards::squareBB(Square::D4.index());
+    REQUIRE(board.attackersTo(Square::E5, occupied) == (expected | Bitboards::squareBB(Square::B2.index())));
+}
+
+TEST_CASE("The attack map of a side holds every attacked square", "[Board][Attacks]") {
+    auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "4k3/4r3/8/4p3/3P4/5N2/1B6/4K3 w - - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+
+    CAPTURE(fen);
+    for (auto color : {PieceColor::White, PieceColor::Black}) {
+        auto attacked = board.attacks(color);
+        for (auto index = 0u; index < 64; ++index) {
+            auto square = Square::fromIndexUnchecked(index);
+            CAPTURE(color, square);
+            REQUIRE(Bitboards::contains(attacked, index) == board.isSquareAttacked(square, color));
+        }
+    }
+}
+
+TEST_CASE("A move gives check exactly when the king is in check after making it", "[Board][Attacks][Check]") {
+    auto fen = GENERATE(
+        "rnbqkbnr/pppp1ppp/8/4p3/6P1/5P2/PPPPP2P/RNBQKBNR b KQkq - 0 2",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        // promotions checking from the last rank and by uncovering the rook
+        "1r2k3/P1P5/8/8/8/8/8/2R1K3 w - - 0 1",
+        // en passant uncovering the bishop and the rook
+        "8/8/8/1k1pP2R/8/8/6B1/4K3 w - d6 0 1",
+        "8/8/8/8/1K1pP2r/8/8/4k3 b - e3 0 1",
+        // castling checks with the rook
+        "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+        "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+    auto moves = Board::MoveVec();
+    board.legalMoves(moves);
+    auto checks = board.checkInfo();
+
+    CAPTURE(fen);
+    auto checking = 0;
+    for (auto move : moves) {
+        auto givesCheck = board.givesCheck(move, checks);
+        board.makeMove(move);
+        CAPTURE(move);
+        REQUIRE(givesCheck == board.isCheck());
+        board.reverseMove(move);
+        checking += givesCheck;
+    }
+    REQUIRE(checking > 0);
+}
+
+TEST_CASE("Any move is validated exactly like the legal move list", "[Board][MoveGen][Legal]") {
+    auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/KPp4r/8/8/8/7k w - c6 0 1",
+        "8/8/8/3pP3/4K3/8/8/k7 w - d6 0 1",
+        "4k3/8/8/8/1b6/8/3P4/R3K1r1 w - - 0 1",
+        "k4r2/8/8/8/8/8/8/R3K2R w KQ - 0 1",
+        "r3k2r/8/8/8/8/8/8/R3K2R b KQkq - 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+    auto moves = Board::MoveVec();
+    board.legalMoves(moves);
+    auto legal = std::set<Move>(moves.begin(), moves.end());
+
+    CAPTURE(fen);
+    auto accepted = std::set<Move>();
+    for (auto from = 0u; from < 64; ++from) {
+        for (auto to = 0u; to < 64; ++to) {
+            auto fromSquare = Square::fromIndexUnchecked(from);
+            auto toSquare = Square::fromIndexUnchecked(to);
+            auto candidates = std::vector<Move>{Move(fromSquare, toSquare)};
+            for (auto promotion : {PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight}) {
+                candidates.emplace_back(fromSquare, toSquare, promotion);
+            }
+            for (auto move : candidates) {
+                if (board.isPseudoLegal(move) && board.isLegal(move)) {
+                    accepted.insert(move);
+                }
+            }
+        }
+    }
+    REQUIRE(accepted == legal);
+}
+
+TEST_CASE("Check, checkmate and stalemate are detected", "[Board][Attacks][Check]") {
+    // https://lichess.org/editor/k7/1Q6/1K6/8/8/8/8/8_b_-_-_0_1
+    auto mate = Fen::createBoard("k7/1Q6/1K6/8/8/8/8/8 b - - 0 1").value();
+    REQUIRE(mate.isCheck());
+    REQUIRE(mate.isCheckMate());
+    REQUIRE_FALSE(mate.isStaleMate());
+    REQUIRE_FALSE(mate.isCheck(PieceColor::White));
+
+    // https://lichess.org/editor/k7/8/1Q6/8/8/8/8/7K_b_-_-_0_1
+    auto stalemate = Fen::createBoard("k7/8/1Q6/8/8/8/8/7K b - - 0 1").value();
+    REQUIRE_FALSE(stalemate.isCheck());
+    REQUIRE_FALSE(stalemate.isCheckMate());
+    REQUIRE(stalemate.isStaleMate());
+}
+
+TEST_CASE("Static exchange evaluation plays out the recaptures on the target square", "[Board][SEE]") {
+    auto see = [](const char* fen, const char* uci) {
+        auto board = Fen::createBoard(fen).value();
+        return board.see(Move::fromUci(uci).value());
+    };
+
+    // an undefended pawn
+    // https://lichess.org/editor/1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3_w_-_-_0_1
+    REQUIRE(see("1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5") == 10);
+    // white stops after losing the knight for the pawn, going on loses more
+    // https://lichess.org/editor/1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3_w_-_-_0_1
+    REQUIRE(see("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5") == -20);
+    // the rook behind the first one joins the exchange
+    // https://lichess.org/editor/3rk3/8/8/3p4/8/8/3R4/K2R4_w_-_-_0_1
+    REQUIRE(see("3rk3/8/8/3p4/8/8/3R4/K2R4 w - - 0 1", "d2d5") == 10);
+    REQUIRE(see("3rk3/8/8/3p4/8/8/3R4/K7 w - - 0 1", "d2d5") == -40);
+    // the king takes back only while nothing defends the target square
+    // https://lichess.org/editor/4k3/8/1n6/3p4/4K3/8/8/3R4_w_-_-_0_1
+    REQUIRE(see("4k3/8/1n6/3p4/4K3/8/8/3R4 w - - 0 1", "d1d5") == -10);
+    REQUIRE(see("3rk3/8/1n6/3p4/4K3/8/8/3R4 w - - 0 1", "d1d5") == -40);
+    // en passant and a promotion that is taken back
+    // https://lichess.org/editor/4k3/8/8/3pP3/8/8/8/4K3_w_-_d6_0_1
+    REQUIRE(see("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6") == 10);
+    // https://lichess.org/editor/1rk5/P7/8/8/8/8/8/4K3_w_-_-_0_1
+    REQUIRE(see("1rk5/P7/8/8/8/8/8/4K3 w - - 0 1", "a7b8q") == 40);
+    REQUIRE(see("r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1", "b7b8q") == -10);
+}
+
+TEST_CASE("Static exchange thresholds agree with the exchange value", "[Board][SEE]") {
+    auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+        "rnbqkb1r/pp1p1ppp/2p5/4P3/2B5/8/PPP1NnPP/RNBQK2R w KQkq - 0 6",
+        "8/8/8/1k1pP2R/8/8/6B1/4K3 w - d6 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+    auto moves = Board::MoveVec();
+    board.legalMoves(moves);
+
+    CAPTURE(fen);
+    for (const auto& move : moves) {
+        auto value = board.see(move);
+        for (auto threshold = -100; threshold <= 100; threshold += 5) {
+            CAPTURE(move, value, threshold);
+            REQUIRE(board.seeGe(move, threshold) == (value >= threshold));
+        }
+    }
+}
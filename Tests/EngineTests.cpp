@@ -6,7 +6,11 @@
 #include "Engine.hpp"
 #include "Fen.hpp"
 #include "Board.hpp"
+#include "NegaMax.hpp"
+#include "PrincipalVariation.hpp"
 #include <iostream>
+#include <limits>
+#include <vector>
 
 static std::unique_ptr<Engine> createEngine() {
     return EngineFactory::createEngine();
@@ -47,3 +51,96 @@ TEST_CASE("Engine detects stalemate", "[Engine][Stalemate]") {
 
     testGameEnd(fen, false);
 }
+
+TEST_CASE("Engine finds the mate with helper threads", "[Engine][Threads]") {
+    auto engine = createEngine();
+    REQUIRE(engine != nullptr);
+    REQUIRE(engine->setOption("Threads", "4"));
+    REQUIRE_FALSE(engine->setOption("Threads", "0"));
+
+    // https://lichess.org/editor/6k1/5ppp/8/8/8/8/8/R5K1_w_-_-_0_1
+    auto board = Fen::createBoard("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    REQUIRE(board.has_value());
+
+    auto pv = engine->pv(board.value());
+    REQUIRE(engine->setOption("Threads", "1"));
+
+    REQUIRE(pv.length() > 0);
+    REQUIRE(*pv.begin() == Move::fromUci("a1a8").value());
+}
+
+TEST_CASE("A search after a threaded search still searches", "[Engine][Threads]") {
+    auto engine = createEngine();
+    REQUIRE(engine != nullptr);
+    REQUIRE(engine->setOption("Threads", "4"));
+    auto mate = Fen::createBoard("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    REQUIRE(mate.has_value());
+    engine->pv(mate.value());
+    REQUIRE(engine->setOption("Threads", "1"));
+
+    // the knight wins the hanging queen, a search that stopped right away would not see it
+    // https://lichess.org/editor/4k3/8/8/3q4/8/2N5/8/4K3_w_-_-_0_1
+    auto board = Fen::createBoard("4k3/8/8/3q4/8/2N5/8/4K3 w - - 0 1").value();
+    auto pvMoves = std::vector<Move>();
+    auto pv = PrincipalVariation(pvMoves, board);
+    auto infinity = std::numeric_limits<int>::max();
+    REQUIRE(NegaMax::negamaxSearch(board, 2, -infinity, infinity, std::numeric_limits<time_t>::max(), pv) == 30);
+}
+
+TEST_CASE("Engine finds the mate with split point search", "[Engine][Threads]") {
+    auto engine = createEngine();
+    REQUIRE(engine != nullptr);
+    REQUIRE(engine->setOption("ParallelSearch", "YBW"));
+    REQUIRE_FALSE(engine->setOption("ParallelSearch", "Split"));
+    REQUIRE(engine->setOption("Threads", "4"));
+
+    // https://lichess.org/editor/6k1/5ppp/8/8/8/8/8/R5K1_w_-_-_0_1
+    auto board = Fen::createBoard("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1");
+    REQUIRE(board.has_value());
+
+    auto pv = engine->pv(board.value());
+    REQUIRE(engine->setOption("Threads", "1"));
+    REQUIRE(engine->setOption("ParallelSearch", "LazySmp"));
+
+    REQUIRE(pv.length() > 0);
+    REQUIRE(*pv.begin() == Move::fromUci("a1a8").value());
+}
+
+TEST_CASE("Mate scores count the plies to the mate, also from the table", "[Engine][Checkmate]") {
+    auto search = [](const char* fen, int depth) {
+        auto board = Fen::createBoard(fen).value();
+        auto pvMoves = std::vector<Move>();
+        auto pv = PrincipalVariation(pvMoves, board);
+        auto infinity = std::numeric_limits<int>::max();
+        return NegaMax::negamaxSearch(board, depth, -infinity, infinity, std::numeric_limits<time_t>::max(), pv);
+    };
+    NegaMax::clearHash();
+
+    // mate in one with Ra1
+    // https://lichess.org/editor/8/k1K5/8/8/8/8/8/7R_w_-_-_2_2
+    REQUIRE(search("8/k1K5/8/8/8/8/8/7R w - - 2 2", 2) == NegaMax::Mate - 1);
+    // mate in two, Kc7 Ka7 reaches the position above two plies from the root and takes its score from the table
+    // https://lichess.org/editor/k7/8/2K5/8/8/8/8/7R_w_-_-_0_1
+    REQUIRE(search("k7/8/2K5/8/8/8/8/7R w - - 0 1", 4) == NegaMax::Mate - 3);
+}
+
+TEST_CASE("Quiescence search plays out captures before evaluating", "[Engine][Quiescence]") {
+    auto quiescence = [](const char* fen) {
+        auto board = Fen::createBoard(fen).value();
+        auto pvMoves = std::vector<Move>();
+        auto pv = PrincipalVariation(pvMoves, board);
+        auto infinity = std::numeric_limits<int>::max();
+        return std::make_pair(NegaMax::quiescence(board, -infinity, infinity, std::numeric_limits<time_t>::max(), pv), board.evaluate());
+    };
+
+    // a knight that takes the hanging queen
+    // https://lichess.org/editor/4k3/8/8/3q4/8/2N5/8/4K3_w_-_-_0_1
+    auto [winning, winningEvaluation] = quiescence("4k3/8/8/3q4/8/2N5/8/4K3 w - - 0 1");
+    REQUIRE(winningEvaluation == -60);
+    REQUIRE(winning == 30);
+
+    // the queen taking the defended pawn would be lost, standing pat is better
+    // https://lichess.org/editor/4k3/8/2p5/3p4/8/8/8/3QK3_w_-_-_0_1
+    auto [standPat, evaluation] = quiescence("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1");
+    REQUIRE(standPat == evaluation);
+}
@@ -0,0 +1,167 @@
+#include "catch2/catch.hpp"
+
+#include "MovePicker.hpp"
+#include "MoveGeneration.hpp"
+#include "Board.hpp"
+#include "Fen.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+static std::vector<Move> pickAll(MovePicker& picker) {
+    auto moves = std::vector<Move>();
+    while (auto move = picker.next()) {
+        moves.push_back(*move);
+    }
+    return moves;
+}
+
+static Move uciMove(const char* uci) {
+    auto move = Move::fromUci(uci);
+    REQUIRE(move.has_value());
+    return *move;
+}
+
+TEST_CASE("The move picker returns every legal move exactly once", "[MovePicker]") {
+    auto fen = GENERATE(
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+    );
+    auto board = Fen::createBoard(fen).value();
+
+    auto legal = Board::MoveVec();
+    board.legalMoves(legal);
+    REQUIRE_FALSE(legal.empty());
+
+    // a legal hash move, a legal killer and killers that are not legal here
+    auto killers = MovePicker::Killers{uciMove("a2a3"), uciMove("e1e4")};
+    auto picker = MovePicker(board, legal.back(), killers);
+    auto picked = pickAll(picker);
+
+    CAPTURE(fen);
+    REQUIRE(picked.front() == legal.back());
+    REQUIRE(picked.size() == legal.size());
+    REQUIRE(std::set<Move>(picked.begin(), picked.end()) == std::set<Move>(legal.begin(), legal.end()));
+}
+
+TEST_CASE("The move picker ignores a hash move that is not legal", "[MovePicker]") {
+    auto board = Fen::createBoard("4k3/8/8/8/8/8/8/4K3 w - - 0 1").value();
+    auto picker = MovePicker(board, uciMove("e2e4"));
+    auto picked = pickAll(picker);
+
+    REQUIRE(picked.size() == 5);
+    REQUIRE(std::find(picked.begin(), picked.end(), uciMove("e2e4")) == picked.end());
+}
+
+TEST_CASE("The move picker orders hash move, captures, killers, quiet moves and bad captures", "[MovePicker]") {
+    // https://lichess.org/editor/4k3/8/2p5/1n1p4/8/2N5/8/3QK2R_w_K_-_0_1
+    auto board = Fen::createBoard("4k3/8/2p5/1n1p4/8/2N5/8/3QK2R w K - 0 1").value();
+    auto killers = MovePicker::Killers{uciMove("d1a4"), std::nullopt};
+    auto picker = MovePicker(board, uciMove("e1g1"), killers);
+    auto picked = pickAll(picker);
+
+    REQUIRE(picked.size() >= 5);
+    REQUIRE(picked[0] == uciMove("e1g1"));
+    // knight takes knight loses nothing
+    REQUIRE(picked[1] == uciMove("c3b5"));
+    REQUIRE(picked[2] == uciMove("d1a4"));
+    // pieces taking a defended pawn come last, the cheaper attacker first
+    REQUIRE(picked[picked.size() - 2] == uciMove("c3d5"));
+    REQUIRE(picked[picked.size() - 1] == uciMove("d1d5"));
+
+    // quiet moves giving check are tried before the other quiet moves
+    auto givesCheck = [&board](const Move& move) {
+        board.makeMove(move);
+        bool check = board.isCheck();
+        board.reverseMove(move);
+        return check;
+    };
+    auto quiets = std::vector<Move>(picked.begin() + 3, picked.end() - 2);
+    REQUIRE(givesCheck(quiets.front()));
+    REQUIRE(std::is_partitioned(quiets.begin(), quiets.end(), givesCheck));
+}
+
+TEST_CASE("Captures come most valuable victim first, then least valuable attacker first", "[MovePicker]") {
+    // https://lichess.org/editor/4k3/8/8/n1r5/1P1P4/1N6/8/2Q1K3_w_-_-_0_1
+    auto board = Fen::createBoard("4k3/8/8/n1r5/1P1P4/1N6/8/2Q1K3 w - - 0 1").value();
+    auto picker = MovePicker(board);
+    auto picked = pickAll(picker);
+
+    REQUIRE(picked.size() > 6);
+    auto pawnTakesRook = std::set<Move>{picked[0], picked[1]};
+    REQUIRE(pawnTakesRook == std::set<Move>{uciMove("b4c5"), uciMove("d4c5")});
+    REQUIRE(picked[2] == uciMove("b3c5"));
+    REQUIRE(picked[3] == uciMove("c1c5"));
+    REQUIRE(picked[4] == uciMove("b4a5"));
+    REQUIRE(picked[5] == uciMove("b3a5"));
+}
+
+TEST_CASE("The move picker for the quiescence search only returns captures that do not lose material", "[MovePicker]") {
+    // https://lichess.org/editor/4k3/8/2p5/1n1p4/8/2N5/8/3QK2R_w_K_-_0_1
+    auto board = Fen::createBoard("4k3/8/2p5/1n1p4/8/2N5/8/3QK2R w K - 0 1").value();
+    auto picker = MovePicker(board, MovePicker::Mode::GoodCaptures);
+    auto picked = pickAll(picker);
+
+    REQUIRE(picked == std::vector<Move>{uciMove("c3b5")});
+}
+
+TEST_CASE("Captures and quiet moves together are the legal moves", "[MovePicker][MoveGen]") {
+    auto fen = GENERATE(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/3pP3/4K3/8/8/k7 w - d6 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+
+    auto all = Board::MoveVec();
+    MoveGeneration::generateLegalMoves(board, all);
+    auto split = Board::MoveVec();
+    MoveGeneration::generateLegalMoves(board, split, MoveGeneration::GenType::Captures);
+    auto captureCount = split.size();
+    MoveGeneration::generateLegalMoves(board, split, MoveGeneration::GenType::Quiets);
+
+    CAPTURE(fen);
+    REQUIRE(captureCount > 0);
+    REQUIRE(split.size() == all.size());
+    REQUIRE(std::set<Move>(split.begin(), split.end()) == std::set<Move>(all.begin(), all.end()));
+    for (auto i = captureCount; i < split.size(); i++) {
+        REQUIRE(MovePicker::isQuiet(board, split[i]));
+    }
+}
+
+TEST_CASE("Quiet checks are the quiet moves that give check", "[MovePicker][MoveGen]") {
+    auto fen = GENERATE(
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "rnbqkbnr/pppp1ppp/8/4p3/6P1/5P2/PPPPP2P/RNBQKBNR b KQkq - 0 2",
+        // discovered checks by a knight, a pawn and the king
+        "4k3/8/8/8/4N3/8/2P5/1B2R1K1 w - - 0 1",
+        "8/7k/8/8/8/8/2P5/1B4K1 w - - 0 1",
+        "8/8/8/8/1k6/8/3K4/4B3 w - - 0 1",
+        // castling checks with the rook
+        "5k2/8/8/8/8/8/8/4K2R w K - 0 1",
+        "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1"
+    );
+    auto board = Fen::createBoard(fen).value();
+
+    auto quiets = Board::MoveVec();
+    MoveGeneration::generateLegalMoves(board, quiets, MoveGeneration::GenType::Quiets);
+    auto expected = std::set<Move>();
+    for (auto move : quiets) {
+        board.makeMove(move);
+        if (board.isCheck()) {
+            expected.insert(move);
+        }
+        board.reverseMove(move);
+    }
+    auto checks = Board::MoveVec();
+    MoveGeneration::generateLegalMoves(board, checks, MoveGeneration::GenType::QuietChecks);
+
+    CAPTURE(fen);
+    REQUIRE(!expected.empty());
+    REQUIRE(checks.size() == expected.size());
+    REQUIRE(std::set<Move>(checks.begin(), checks.end()) == expected);
+}
@@ -3,7 +3,9 @@
 #include "TestUtils.hpp"
 
 #include "Move.hpp"
+#include "MoveList.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 TEST_CASE("Moves store the squares they are constructed with", "[Move][Fundamental]") {
@@ -109,3 +111,43 @@ TEST_CASE("Moves are not created from invalid UCI notation", "[Move][Fundamental
     CAPTURE(uci, move);
     REQUIRE_FALSE(move.has_value());
 }
+
+TEST_CASE("Move lists store moves in order", "[Move][MoveList]") {
+    auto e2e4 = Move(Square::E2, Square::E4);
+    auto g1f3 = Move(Square::G1, Square::F3);
+    auto d7d8 = Move(Square::D7, Square::D8, PieceType::Queen);
+
+    auto moves = MoveList();
+    REQUIRE(moves.empty());
+
+    moves.push_back(e2e4);
+    moves.push_back(g1f3);
+    moves.push_back(d7d8);
+    REQUIRE(moves.size() == 3);
+    REQUIRE(moves.front() == e2e4);
+    REQUIRE(moves[1] == g1f3);
+    REQUIRE(moves.back() == d7d8);
+    REQUIRE(std::find(moves.begin(), moves.end(), g1f3) != moves.end());
+
+    moves.erase(moves.begin());
+    REQUIRE(moves.size() == 2);
+    REQUIRE(moves.front() == g1f3);
+
+    moves.clear();
+    REQUIRE(moves.empty());
+    REQUIRE(moves.begin() == moves.end());
+}
+
+TEST_CASE("Move lists support erase-remove", "[Move][MoveList]") {
+    auto moves = MoveList{
+        Move(Square::A2, Square::A3), Move(Square::B1, Square::C3),
+        Move(Square::A2, Square::A4), Move(Square::G1, Square::F3)
+    };
+    auto isPawnMove = [](const Move& move) { return move.from() == Square::A2; };
+    moves.erase(std::remove_if(moves.begin(), moves.end(), isPawnMove), moves.end());
+
+    REQUIRE(moves.size() == 2);
+    REQUIRE(moves[0] == Move(Square::B1, Square::C3));
+    REQUIRE(moves[1] == Move(Square::G1, Square::F3));
+    REQUIRE(MoveList::capacity() >= 218);
+}
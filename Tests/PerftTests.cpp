@@ -0,0 +1,137 @@
+#include "catch2/catch.hpp"
+
+#include "Perft.hpp"
+#include "Bench.hpp"
+#include "Board.hpp"
+#include "Fen.hpp"
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// https://www.chessprogramming.org/Perft_Results
+static const char* const Kiwipete = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+static const char* const Position3 = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+static const char* const Position4 = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+static const char* const Position5 = "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8";
+static const char* const Position6 = "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10";
+
+static void testPerft(const char* fen, int depth, std::uint64_t expectedNodes) {
+    auto board = Fen::createBoard(fen).value();
+    auto key = board.key();
+
+    CAPTURE(fen, depth);
+    REQUIRE(Perft::count(board, depth) == expectedNodes);
+    // every move was taken back
+    REQUIRE(board.key() == key);
+}
+
+TEST_CASE("Perft of the starting position", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {0, 1}, {1, 20}, {2, 400}, {3, 8902}, {4, 197281}
+    }));
+    testPerft(Fen::StartingPos, depth, nodes);
+}
+
+TEST_CASE("Perft of Kiwipete", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {1, 48}, {2, 2039}, {3, 97862}
+    }));
+    testPerft(Kiwipete, depth, nodes);
+}
+
+TEST_CASE("Perft of position 3", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {1, 14}, {2, 191}, {3, 2812}, {4, 43238}, {5, 674624}
+    }));
+    testPerft(Position3, depth, nodes);
+}
+
+TEST_CASE("Perft of position 4", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {1, 6}, {2, 264}, {3, 9467}, {4, 422333}
+    }));
+    testPerft(Position4, depth, nodes);
+}
+
+TEST_CASE("Perft of position 5", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {1, 44}, {2, 1486}, {3, 62379}
+    }));
+    testPerft(Position5, depth, nodes);
+}
+
+TEST_CASE("Perft of position 6", "[Perft]") {
+    auto [depth, nodes] = GENERATE(table<int, std::uint64_t>({
+        {1, 46}, {2, 2079}, {3, 89890}
+    }));
+    testPerft(Position6, depth, nodes);
+}
+
+// the deeper counts take a few seconds in an optimized build, run them with [.PerftDeep]
+TEST_CASE("Perft of the standard positions at depth", "[.PerftDeep]") {
+    auto [fen, depth, nodes] = GENERATE(table<const char*, int, std::uint64_t>({
+        {Fen::StartingPos, 5, 4865609},
+        {Kiwipete, 4, 4085603},
+        {Position3, 6, 11030083},
+        {Position4, 5, 15833292},
+        {Position5, 4, 2103487},
+        {Position6, 4, 3894594}
+    }));
+    testPerft(fen, depth, nodes);
+}
+
+TEST_CASE("Perft divide reports the nodes below every root move", "[Perft]") {
+    auto board = Fen::createBoard(Kiwipete).value();
+    auto output = std::stringstream();
+
+    REQUIRE(Perft::divide(board, 2, output) == 2039);
+
+    auto text = output.str();
+    REQUIRE(text.find("e1g1: 43\n") != std::string::npos);
+    REQUIRE(text.find("e5f7: 44\n") != std::string::npos);
+    REQUIRE(text.find("Nodes searched: 2039\n") != std::string::npos);
+}
+
+TEST_CASE("Perft with a cache gives the same counts", "[Perft][Cache]") {
+    auto [fen, depth, nodes] = GENERATE(table<const char*, int, std::uint64_t>({
+        {Kiwipete, 3, 97862},
+        {Position3, 5, 674624},
+        {Position4, 4, 422333}
+    }));
+    auto board = Fen::createBoard(fen).value();
+    auto cache = Perft::Cache(1);
+
+    CAPTURE(fen, depth);
+    REQUIRE(Perft::count(board, depth, &cache) == nodes);
+    // the second run is answered from the cache
+    REQUIRE(Perft::count(board, depth, &cache) == nodes);
+}
+
+TEST_CASE("Perft split over threads gives the same counts", "[Perft][Threads]") {
+    auto [fen, depth, nodes] = GENERATE(table<const char*, int, std::uint64_t>({
+        {Fen::StartingPos, 4, 197281},
+        {Kiwipete, 3, 97862},
+        {Position5, 3, 62379}
+    }));
+    auto hashMegabytes = GENERATE(0, 1);
+    auto board = Fen::createBoard(fen).value();
+    auto key = board.key();
+    auto output = std::stringstream();
+
+    CAPTURE(fen, depth, hashMegabytes);
+    REQUIRE(Perft::divide(board, depth, output, 4, hashMegabytes) == nodes);
+    REQUIRE(board.key() == key);
+    REQUIRE(output.str().find("Thread 3: ") != std::string::npos);
+    // the speedup is only measured on request, without running perft a second time
+    REQUIRE(output.str().find("Scaling: ") == std::string::npos);
+}
+
+TEST_CASE("Perft scaling is measured against a run on one thread", "[Perft][Threads]") {
+    auto board = Fen::createBoard(Kiwipete).value();
+    auto output = std::stringstream();
+
+    REQUIRE(Bench::perftScaling(output, board, 3, 2, 1) == 97862);
+    REQUIRE(output.str().find("1 thread") != std::string::npos);
+    REQUIRE(output.str().find("Scaling: ") != std::string::npos);
+}
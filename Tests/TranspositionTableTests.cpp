@@ -0,0 +1,71 @@
+#include "catch2/catch.hpp"
+
+#include "TranspositionTable.hpp"
+#include "Move.hpp"
+#include "Square.hpp"
+
+#include <cstdint>
+
+using Bound = TranspositionTable::Bound;
+
+TEST_CASE("Stored search results are found by their key", "[TranspositionTable]") {
+    auto table = TranspositionTable(1);
+    auto move = Move(Square::E7, Square::E8, PieceType::Knight);
+    Zobrist::Key key = 0x0123456789ABCDEFULL;
+
+    REQUIRE_FALSE(table.probe(key).has_value());
+
+    table.store(key, move, -1234, 7, Bound::Lower);
+    auto result = table.probe(key);
+    REQUIRE(result.has_value());
+    REQUIRE(result->move == move);
+    REQUIRE(result->move->promotion() == PieceType::Knight);
+    REQUIRE(result->score == -1234);
+    REQUIRE(result->depth == 7);
+    REQUIRE(result->bound == Bound::Lower);
+
+    // another key of the same cluster does not match
+    REQUIRE_FALSE(table.probe(key ^ (Zobrist::Key(1) << 63)).has_value());
+
+    // a result without a move keeps the move stored before
+    table.store(key, std::nullopt, 50, 8, Bound::Upper);
+    result = table.probe(key);
+    REQUIRE(result.has_value());
+    REQUIRE(result->move == move);
+    REQUIRE(result->score == 50);
+    REQUIRE(result->bound == Bound::Upper);
+
+    table.clear();
+    REQUIRE_FALSE(table.probe(key).has_value());
+}
+
+TEST_CASE("A full cluster keeps the deepest results and the newest one", "[TranspositionTable]") {
+    // less than a megabyte gives a single cluster, every key lands in it
+    auto table = TranspositionTable(0);
+    auto move = Move(Square::E2, Square::E4);
+
+    table.store(1, move, 0, 10, Bound::Exact);
+    table.store(2, move, 0, 9, Bound::Exact);
+    table.store(3, move, 0, 8, Bound::Exact);
+    table.store(4, move, 0, 1, Bound::Exact);
+    // too shallow for the depth-preferred entries, so it takes the always-replace entry
+    table.store(5, move, 0, 2, Bound::Exact);
+
+    REQUIRE(table.probe(1).has_value());
+    REQUIRE(table.probe(2).has_value());
+    REQUIRE(table.probe(3).has_value());
+    REQUIRE_FALSE(table.probe(4).has_value());
+    REQUIRE(table.probe(5).has_value());
+
+    // a shallower result of the same search does not replace a deeper one of the same position
+    table.store(1, move, 99, 3, Bound::Lower);
+    REQUIRE(table.probe(1)->depth == 10);
+
+    // in the next search the shallowest entry of the earlier search goes first
+    table.newSearch();
+    table.store(6, move, 0, 1, Bound::Exact);
+    REQUIRE(table.probe(1).has_value());
+    REQUIRE(table.probe(2).has_value());
+    REQUIRE_FALSE(table.probe(3).has_value());
+    REQUIRE(table.probe(6).has_value());
+}
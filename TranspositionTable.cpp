@@ -0,0 +1,108 @@
+#include "TranspositionTable.hpp"
+
+#include <algorithm>
+
+static_assert(sizeof(std::atomic<std::uint64_t>) == 8, "an entry should be two 64 bit words");
+
+static constexpr int GenerationBits = 6;
+static constexpr std::uint8_t GenerationMask = (1 << GenerationBits) - 1;
+
+static std::uint64_t pack(Move::Optional move, int score, int depth, TranspositionTable::Bound bound, std::uint8_t generation) {
+    std::uint64_t data = move.has_value() ? move->raw() : 0;
+    data |= (std::uint64_t) (std::uint32_t) score << 16;
+    data |= (std::uint64_t) std::clamp(depth, 0, 255) << 48;
+    data |= (std::uint64_t) bound << 56;
+    data |= (std::uint64_t) generation << 58;
+    return data;
+}
+
+// a move is never stored as 0, that would be a1a1
+static Move::Optional moveOf(std::uint64_t data) {
+    std::uint16_t raw = (std::uint16_t) data;
+    if(raw == 0) return std::nullopt;
+    return Move::fromRaw(raw);
+}
+
+static int depthOf(std::uint64_t data) {
+    return (int) ((data >> 48) & 0xFF);
+}
+
+static TranspositionTable::Bound boundOf(std::uint64_t data) {
+    return (TranspositionTable::Bound) ((data >> 56) & 3);
+}
+
+static std::uint8_t generationOf(std::uint64_t data) {
+    return (std::uint8_t) (data >> 58);
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) : mask_(0), generation_(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    // the largest power of two number of clusters that fits, at least one
+    std::size_t count = 1;
+    while(count * 2 * sizeof(Cluster) <= megabytes * 1024 * 1024) count *= 2;
+    // value-initialized, an all-zero entry has no bound and never matches
+    clusters_ = std::make_unique<Cluster[]>(count);
+    mask_ = count - 1;
+}
+
+void TranspositionTable::clear() {
+    for(std::size_t i = 0; i <= mask_; i++){
+        for(Entry& entry : clusters_[i].entries){
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation_ = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation_ = (generation_ + 1) & GenerationMask;
+}
+
+std::optional<TranspositionTable::Result> TranspositionTable::probe(Zobrist::Key key) const {
+    const Cluster& cluster = clusters_[key & mask_];
+    for(const Entry& entry : cluster.entries){
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        std::uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if((check ^ data) != key || boundOf(data) == Bound::None) continue;
+        return Result{moveOf(data), (int) (std::int32_t) (std::uint32_t) (data >> 16), depthOf(data), boundOf(data)};
+    }
+    return std::nullopt;
+}
+
+void TranspositionTable::store(Zobrist::Key key, Move::Optional move, int score, int depth, Bound bound) {
+    Cluster& cluster = clusters_[key & mask_];
+    auto isOld = [this](std::uint64_t data){ return generationOf(data) != generation_; };
+
+    // the same position is updated in place, unless that would replace a deeper result of this search
+    for(Entry& entry : cluster.entries){
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        if((entry.check.load(std::memory_order_relaxed) ^ data) != key || boundOf(data) == Bound::None) continue;
+        if(depth < depthOf(data) && bound != Bound::Exact && !isOld(data)) return;
+        // a result without a move keeps the move found before
+        if(!move.has_value()) move = moveOf(data);
+        data = pack(move, score, depth, bound, generation_);
+        entry.check.store(key ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+        return;
+    }
+
+    // the weakest depth-preferred entry: one of an earlier search, otherwise the shallowest
+    Entry* weakest = &cluster.entries[0];
+    for(int i = 1; i < ClusterSize - 1; i++){
+        std::uint64_t data = cluster.entries[i].data.load(std::memory_order_relaxed);
+        std::uint64_t weakestData = weakest->data.load(std::memory_order_relaxed);
+        if(isOld(data) != isOld(weakestData) ? isOld(data) : depthOf(data) < depthOf(weakestData)) weakest = &cluster.entries[i];
+    }
+    std::uint64_t weakestData = weakest->data.load(std::memory_order_relaxed);
+    Entry* target = weakest;
+    if(!isOld(weakestData) && boundOf(weakestData) != Bound::None && depth < depthOf(weakestData))
+        target = &cluster.entries[ClusterSize - 1];
+
+    std::uint64_t data = pack(move, score, depth, bound, generation_);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+    target->data.store(data, std::memory_order_relaxed);
+}
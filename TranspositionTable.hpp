@@ -0,0 +1,74 @@
+#ifndef CHESS_ENGINE_TRANSPOSITIONTABLE_HPP
+#define CHESS_ENGINE_TRANSPOSITIONTABLE_HPP
+
+#include "Move.hpp"
+#include "Zobrist.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+
+// Search results of positions seen before, shared by all search threads without locks.
+// A key maps to one cluster of entries that fills a cache line. As in the perft cache an
+// entry stores its data and its key XOR its data, so an entry torn by concurrent writes fails the check.
+class TranspositionTable {
+public:
+    // how the stored score relates to the score of the position
+    enum class Bound : std::uint8_t {
+        None,
+        Upper, // no move reached alpha, the score is at most this
+        Lower, // a move reached beta, the score is at least this
+        Exact
+    };
+
+    struct Result {
+        Move::Optional move;
+        int score;
+        int depth;
+        Bound bound;
+    };
+
+    explicit TranspositionTable(std::size_t megabytes);
+
+    // drops every entry
+    void resize(std::size_t megabytes);
+    void clear();
+    // entries of earlier searches are replaced before those of the current one
+    void newSearch();
+
+    std::optional<Result> probe(Zobrist::Key key) const;
+    void store(Zobrist::Key key, Move::Optional move, int score, int depth, Bound bound);
+
+    // start loading the cluster of key into the cache, well before it is probed
+    void prefetch(Zobrist::Key key) const {
+#if defined(__GNUC__)
+        __builtin_prefetch(&clusters_[key & mask_]);
+#elif defined(_MSC_VER)
+        _mm_prefetch((const char*) &clusters_[key & mask_], _MM_HINT_T0);
+#endif
+    }
+
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data; // move | score << 16 | depth << 48 | bound << 56 | generation << 58
+    };
+
+    // the first entries keep the deepest results, the last one always takes the newest
+    static constexpr int ClusterSize = 4;
+    struct alignas(64) Cluster {
+        Entry entries[ClusterSize];
+    };
+
+    std::unique_ptr<Cluster[]> clusters_;
+    std::size_t mask_;
+    std::uint8_t generation_;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "Uci.hpp"
 
 #include "Fen.hpp"
+#include "Perft.hpp"
 
 #include <utility>
 #include <iostream>
@@ -38,10 +39,14 @@ void Uci::runCommand(const std::string& line) {
         isreadyCommand(stream);
     } else if (command == "ucinewgame") {
         ucinewgameCommand(stream);
+    } else if (command == "setoption") {
+        setoptionCommand(stream);
     } else if (command == "position") {
         positionCommand(stream);
     } else if (command == "go") {
         goCommand(stream);
+    } else if (command == "perft") {
+        perftCommand(stream);
     } else if (command == "quit") {
         quitCommand(stream);
     }
@@ -56,6 +61,10 @@ void Uci::uciCommand(std::istream&) {
     authorCommand << "id author " << engine_->author();
     sendCommand(authorCommand.str());
 
+    for (const auto& option : engine_->options()) {
+        sendCommand("option " + option);
+    }
+
     sendCommand("uciok");
 }
 
@@ -67,6 +76,32 @@ void Uci::ucinewgameCommand(std::istream&) {
     engine_->newGame();
 }
 
+void Uci::setoptionCommand(std::istream& stream) {
+    // setoption name <id> [value <x>], both id and x may contain spaces
+    auto name = std::string();
+    auto value = std::string();
+    auto* field = static_cast<std::string*>(nullptr);
+
+    for (std::string token; stream >> token;) {
+        if (token == "name" && field == nullptr) {
+            field = &name;
+        } else if (token == "value" && field == &name) {
+            field = &value;
+        } else if (field != nullptr) {
+            if (!field->empty()) {
+                *field += ' ';
+            }
+
+            *field += token;
+        }
+    }
+
+    if (!engine_->setOption(name, value)) {
+        // unknown options are ignored, as the protocol asks
+        log_ << "UCI warning: option " << name << " not set to '" << value << "'" << std::endl;
+    }
+}
+
 void Uci::positionCommand(std::istream& stream) {
     auto type = std::string();
     stream >> type;
@@ -184,6 +219,34 @@ void Uci::goCommand(std::istream& stream) {
     sendCommand(bestMoveCmd.str());
 }
 
+void Uci::perftCommand(std::istream& stream) {
+    // not part of UCI: perft <depth> [threads <n>] [hash <mb>] counts the leaf nodes below the current position
+    auto depth = readValue<int>(stream);
+
+    if (!depth.has_value()) {
+        error("perft needs a depth");
+        return;
+    }
+
+    auto threads = 1u;
+    auto hashMegabytes = std::size_t(0);
+
+    for (std::string token; stream >> token;) {
+        if (token == "threads") {
+            threads = readValue<unsigned>(stream).value_or(threads);
+        } else if (token == "hash") {
+            hashMegabytes = readValue<std::size_t>(stream).value_or(hashMegabytes);
+        }
+    }
+
+    auto output = std::stringstream();
+    Perft::divide(board_, depth.value(), output, threads, hashMegabytes);
+
+    for (std::string line; std::getline(output, line);) {
+        sendCommand(line);
+    }
+}
+
 void Uci::quitCommand(std::istream&) {
     std::exit(EXIT_SUCCESS);
 }
@@ -25,8 +25,10 @@ private:
     void uciCommand(std::istream& stream);
     void isreadyCommand(std::istream& stream);
     void ucinewgameCommand(std::istream& stream);
+    void setoptionCommand(std::istream& stream);
     void positionCommand(std::istream& stream);
     void goCommand(std::istream& stream);
+    void perftCommand(std::istream& stream);
     void quitCommand(std::istream& stream);
     TimeInfo::Optional readTimeInfo(std::istream& stream);
     void sendPvInfo(const PrincipalVariation& pv);
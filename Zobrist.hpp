@@ -0,0 +1,68 @@
+#ifndef CHESS_ENGINE_ZOBRIST_HPP
+#define CHESS_ENGINE_ZOBRIST_HPP
+
+#include "Piece.hpp"
+#include "Square.hpp"
+#include "CastlingRights.hpp"
+
+#include <cstdint>
+
+// Random keys used to hash positions. A position's key is the XOR of the keys
+// of its pieces, the side to move, its castling rights and its en passant file,
+// so it can be updated incrementally when a move is made or reversed.
+namespace Zobrist {
+    using Key = std::uint64_t;
+
+    struct Keys {
+        Key pieceSquare[12][64];
+        Key blackToMove;
+        Key castling[16];
+        Key enPassantFile[8];
+    };
+
+    // splitmix64, good enough to fill the tables at compile time
+    constexpr Key nextRandom(Key& state) {
+        Key z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    constexpr Keys generateKeys() {
+        Keys keys{};
+        Key state = 0x0123456789ABCDEFULL;
+        for (auto& pieceKeys : keys.pieceSquare) {
+            for (auto& key : pieceKeys) key = nextRandom(state);
+        }
+        keys.blackToMove = nextRandom(state);
+        // a set of castling rights hashes to the XOR of its single rights
+        Key single[4] = {nextRandom(state), nextRandom(state), nextRandom(state), nextRandom(state)};
+        for (int cr = 0; cr < 16; ++cr) {
+            for (int bit = 0; bit < 4; ++bit) {
+                if (cr & (1 << bit)) keys.castling[cr] ^= single[bit];
+            }
+        }
+        for (auto& key : keys.enPassantFile) key = nextRandom(state);
+        return keys;
+    }
+
+    inline constexpr Keys keys = generateKeys();
+
+    constexpr Key piece(Piece piece, Square square) {
+        return keys.pieceSquare[piece.index()][square.index()];
+    }
+
+    constexpr Key side() {
+        return keys.blackToMove;
+    }
+
+    constexpr Key castling(CastlingRights cr) {
+        return keys.castling[static_cast<unsigned>(cr) & 15];
+    }
+
+    constexpr Key enPassant(Square square) {
+        return keys.enPassantFile[square.file()];
+    }
+}
+
+#endif